@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""Compares two sets of Google Benchmark JSON results.
+
+Usage: compare.py BASELINE CONTENDER [--metric cpu_time] [--threshold 0.05]
+
+BASELINE and CONTENDER are JSON files written with --benchmark_out, or
+directories of them such as those made by run_benchmarks.sh. The metric
+is cpu_time, real_time, or a user counter such as allocs or instructions;
+higher is worse. With repetitions, the median (or else the mean) aggregate
+is compared. Exits with status 1 if any benchmark got worse by more than
+the threshold.
+"""
+
+import argparse
+import json
+import os
+import sys
+
+_UNIT_TO_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+_TIME_METRICS = ("cpu_time", "real_time")
+
+
+def _load_file(path, metric):
+    with open(path) as f:
+        runs = json.load(f).get("benchmarks", [])
+    results = {}
+    preferred = {}
+    for run in runs:
+        if run.get("error_occurred") or metric not in run:
+            continue
+        name = run.get("run_name", run["name"])
+        value = run[metric]
+        if metric in _TIME_METRICS:
+            value *= _UNIT_TO_NS[run.get("time_unit", "ns")]
+        if run.get("run_type") == "aggregate":
+            rank = {"median": 0, "mean": 1}.get(run.get("aggregate_name"))
+            if rank is None:
+                continue
+        else:
+            rank = 2
+        # Keep the best-ranked entry; among plain iterations, the first one.
+        if name not in preferred or rank < preferred[name]:
+            preferred[name] = rank
+            results[name] = value
+    return results
+
+
+def load(path, metric):
+    """Maps "file:benchmark" names to the metric, with times in nanoseconds."""
+    if os.path.isdir(path):
+        files = sorted(os.path.join(path, f) for f in os.listdir(path) if f.endswith(".json"))
+    else:
+        files = [path]
+    results = {}
+    for file in files:
+        suite = os.path.splitext(os.path.basename(file))[0]
+        for name, value in _load_file(file, metric).items():
+            results[suite + ":" + name] = value
+    return results
+
+
+def _format(value, metric):
+    if metric not in _TIME_METRICS:
+        return "%.4g" % value
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if value >= scale:
+            return "%.3g %s" % (value / scale, unit)
+    return "%.3g ns" % value
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--metric", default="cpu_time",
+                        help="cpu_time, real_time or a counter name (default: cpu_time)")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="relative increase reported as a regression (default: 0.05)")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline, args.metric)
+    contender = load(args.contender, args.metric)
+    common = [name for name in baseline if name in contender]
+    if not common:
+        print("No benchmarks in common.", file=sys.stderr)
+        return 2
+
+    width = max(len(name) for name in common)
+    print("%-*s %12s %12s %9s" % (width, "Benchmark", "Baseline", "Contender", "Change"))
+    regressions = []
+    for name in common:
+        old, new = baseline[name], contender[name]
+        if old > 0:
+            change = (new - old) / old
+        else:
+            change = float("inf") if new > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions.append(name)
+        elif change < -args.threshold:
+            flag = "  improved"
+        print("%-*s %12s %12s %+8.1f%%%s" % (width, name, _format(old, args.metric), _format(new, args.metric), 100 * change, flag))
+
+    for label, names in (("Only in baseline", set(baseline) - set(contender)),
+                         ("Only in contender", set(contender) - set(baseline))):
+        if names:
+            print("\n%s: %s" % (label, ", ".join(sorted(names))))
+
+    if regressions:
+        print("\n%d of %d benchmarks regressed by more than %.0f%%." %
+              (len(regressions), len(common), 100 * args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
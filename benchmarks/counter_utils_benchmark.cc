@@ -0,0 +1,129 @@
+/**
+ * @file counter_utils_benchmark.cc
+ * @brief Benchmarks for CounterTp counting, merging and serialization.
+ */
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/instrumentation.h"
+#include "src/utils/counter_utils.h"
+
+namespace cpp_utils {
+namespace benchmarks {
+namespace {
+
+struct Event {
+    std::string user;
+    int64_t bucket;
+};
+
+// Events over range(0) distinct users with a skewed, Zipf-like popularity.
+std::vector<Event> MakeEvents(size_t count, int64_t distinct) {
+    std::mt19937 rng(7);
+    std::exponential_distribution<double> rank(5.0 / static_cast<double>(distinct));
+    std::vector<Event> events;
+    events.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto r = static_cast<int64_t>(rank(rng)) % distinct;
+        events.push_back({"user" + std::to_string(r), r});
+    }
+    return events;
+}
+
+utils::CounterTp<std::string, Event> MakeStringCounter() {
+    return utils::CounterTp<std::string, Event>([](const Event& e) { return e.user; });
+}
+
+void BM_CounterCountString(benchmark::State& state) {
+    const auto events = MakeEvents(1 << 14, state.range(0));
+    for (auto _ : Instrument(state)) {
+        auto counter = MakeStringCounter();
+        for (const auto& event : events) {
+            counter.Count(event);
+        }
+        benchmark::DoNotOptimize(counter.GetCountMap().size());
+    }
+    state.SetItemsProcessed(state.iterations() * events.size());
+}
+BENCHMARK(BM_CounterCountString)->Range(16, 1 << 14);
+
+void BM_CounterCountInt(benchmark::State& state) {
+    const auto events = MakeEvents(1 << 14, state.range(0));
+    for (auto _ : Instrument(state)) {
+        utils::CounterTp<int64_t, Event> counter([](const Event& e) { return e.bucket; });
+        for (const auto& event : events) {
+            counter.Count(event);
+        }
+        benchmark::DoNotOptimize(counter.GetCountMap().size());
+    }
+    state.SetItemsProcessed(state.iterations() * events.size());
+}
+BENCHMARK(BM_CounterCountInt)->Range(16, 1 << 14);
+
+void BM_CounterMerge(benchmark::State& state) {
+    auto a = MakeStringCounter();
+    auto b = MakeStringCounter();
+    for (const auto& event : MakeEvents(1 << 16, state.range(0))) {
+        a.Count(event);
+        b.Add(event.user + "x");
+    }
+    for (auto _ : Instrument(state)) {
+        auto merged = a;
+        merged.Merge(b);
+        benchmark::DoNotOptimize(merged.GetCountMap().size());
+    }
+    state.SetItemsProcessed(state.iterations() * b.GetCountMap().size());
+}
+BENCHMARK(BM_CounterMerge)->Range(16, 1 << 14);
+
+void BM_CounterSerialize(benchmark::State& state) {
+    auto counter = MakeStringCounter();
+    for (const auto& event : MakeEvents(1 << 16, state.range(0))) {
+        counter.Count(event);
+    }
+    size_t bytes = 0;
+    for (auto _ : Instrument(state)) {
+        const std::string snapshot = counter.Serialize();
+        bytes = snapshot.size();
+        benchmark::DoNotOptimize(snapshot.data());
+    }
+    state.SetItemsProcessed(state.iterations() * counter.GetCountMap().size());
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_CounterSerialize)->Range(16, 1 << 14);
+
+void BM_CounterDeserialize(benchmark::State& state) {
+    auto counter = MakeStringCounter();
+    for (const auto& event : MakeEvents(1 << 16, state.range(0))) {
+        counter.Count(event);
+    }
+    const std::string snapshot = counter.Serialize();
+    auto restored = MakeStringCounter();
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(restored.Deserialize(snapshot));
+    }
+    state.SetItemsProcessed(state.iterations() * counter.GetCountMap().size());
+    state.SetBytesProcessed(state.iterations() * snapshot.size());
+}
+BENCHMARK(BM_CounterDeserialize)->Range(16, 1 << 14);
+
+void BM_CounterGetReverseByValue(benchmark::State& state) {
+    auto counter = MakeStringCounter();
+    for (const auto& event : MakeEvents(1 << 16, state.range(0))) {
+        counter.Count(event);
+    }
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(counter.GetReverseByValue());
+    }
+    state.SetItemsProcessed(state.iterations() * counter.GetCountMap().size());
+}
+BENCHMARK(BM_CounterGetReverseByValue)->Range(16, 1 << 14);
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace cpp_utils
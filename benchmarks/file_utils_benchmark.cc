@@ -0,0 +1,202 @@
+/**
+ * @file file_utils_benchmark.cc
+ * @brief Benchmarks for whole-file and line-oriented reads and writes.
+ *
+ * Input files are written once per benchmark and read back from the page
+ * cache, so these measure the library's copying and syscall overhead
+ * rather than the disk.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/instrumentation.h"
+#include "src/utils/batch_io.h"
+#include "src/utils/compressed_file.h"
+#include "src/utils/file_utils.h"
+#include "src/utils/line_reader.h"
+#include "src/utils/mapped_file.h"
+#include "src/utils/parallel_file.h"
+
+namespace cpp_utils {
+namespace benchmarks {
+namespace {
+
+// Log-like text: lines of 20..200 printable bytes.
+std::string MakeLines(size_t size) {
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<size_t> length(20, 200);
+    std::uniform_int_distribution<int> letter(' ', '~');
+    std::string text;
+    text.reserve(size + 256);
+    while (text.size() < size) {
+        const size_t n = length(rng);
+        for (size_t i = 0; i < n; ++i) {
+            text.push_back(static_cast<char>(letter(rng)));
+        }
+        text.push_back('\n');
+    }
+    return text;
+}
+
+// A scratch file that is removed when the benchmark finishes.
+class ScratchFile {
+public:
+    ScratchFile(std::string_view name, std::string_view contents)
+        : path_(std::filesystem::temp_directory_path() / ("cpp_utils_benchmark_" + std::string(name))) {
+        utils::WriteFile(path_, contents);
+    }
+    ~ScratchFile() { std::filesystem::remove(path_); }
+
+    const std::filesystem::path& path() const { return path_; }
+
+private:
+    std::filesystem::path path_;
+};
+
+void BM_ReadFile(benchmark::State& state) {
+    const ScratchFile file("read_file", MakeLines(state.range(0)));
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(utils::ReadFile(file.path()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReadFile)->Range(1 << 12, 1 << 26);
+
+void BM_MappedFileScan(benchmark::State& state) {
+    const ScratchFile file("mapped_file", MakeLines(state.range(0)));
+    for (auto _ : Instrument(state)) {
+        auto mapped = utils::MappedFile::Open(file.path());
+        uint64_t sum = 0;
+        for (char c : mapped->View()) {
+            sum += static_cast<unsigned char>(c);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MappedFileScan)->Range(1 << 12, 1 << 26);
+
+void BM_ReadLines(benchmark::State& state) {
+    const ScratchFile file("read_lines", MakeLines(state.range(0)));
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(utils::ReadLines(file.path()));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReadLines)->Range(1 << 16, 1 << 26);
+
+void BM_LineReader(benchmark::State& state) {
+    const ScratchFile file("line_reader", MakeLines(state.range(0)));
+    for (auto _ : Instrument(state)) {
+        auto reader = utils::LineReader::Open(file.path());
+        std::string_view line;
+        size_t total = 0;
+        while (reader->Next(&line)) {
+            total += line.size();
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LineReader)->Range(1 << 16, 1 << 26);
+
+void BM_ParallelForEachLine(benchmark::State& state) {
+    const ScratchFile file("parallel_lines", MakeLines(1 << 26));
+    for (auto _ : Instrument(state)) {
+        std::atomic<size_t> total{0};
+        utils::ParallelForEachLine(
+            file.path(), [&](std::string_view line) { total.fetch_add(line.size(), std::memory_order_relaxed); },
+            static_cast<size_t>(state.range(0)));
+        benchmark::DoNotOptimize(total.load());
+    }
+    state.SetBytesProcessed(state.iterations() * (int64_t{1} << 26));
+}
+BENCHMARK(BM_ParallelForEachLine)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+// Many small files, read one by one and as a batch.
+class SmallFiles {
+public:
+    explicit SmallFiles(size_t count) {
+        directory_ = std::filesystem::temp_directory_path() / "cpp_utils_benchmark_small_files";
+        std::filesystem::create_directories(directory_);
+        const std::string contents = MakeLines(4096);
+        for (size_t i = 0; i < count; ++i) {
+            paths_.push_back(directory_ / ("file" + std::to_string(i)));
+            utils::WriteFile(paths_.back(), contents);
+        }
+    }
+    ~SmallFiles() { std::filesystem::remove_all(directory_); }
+
+    const std::vector<std::filesystem::path>& paths() const { return paths_; }
+
+private:
+    std::filesystem::path directory_;
+    std::vector<std::filesystem::path> paths_;
+};
+
+void BM_ReadFileLoop(benchmark::State& state) {
+    const SmallFiles files(static_cast<size_t>(state.range(0)));
+    for (auto _ : Instrument(state)) {
+        for (const auto& path : files.paths()) {
+            benchmark::DoNotOptimize(utils::ReadFile(path));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReadFileLoop)->Arg(64)->Arg(1024);
+
+void BM_BatchIoReadFiles(benchmark::State& state) {
+    const SmallFiles files(static_cast<size_t>(state.range(0)));
+    utils::BatchIo io;
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(io.ReadFiles(files.paths()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetLabel(io.EngineName());
+}
+BENCHMARK(BM_BatchIoReadFiles)->Arg(64)->Arg(1024)->UseRealTime();
+
+void BM_WriteFile(benchmark::State& state) {
+    const std::string contents = MakeLines(state.range(0));
+    const ScratchFile file("write_file", "");
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(utils::WriteFile(file.path(), contents));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_WriteFile)->Range(1 << 12, 1 << 24);
+
+void BM_WriteFileAtomic(benchmark::State& state) {
+    const std::string contents = MakeLines(state.range(0));
+    const ScratchFile file("write_file_atomic", "");
+    utils::WriteOptions options;
+    options.atomic = true;
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(utils::WriteFile(file.path(), contents, options));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_WriteFileAtomic)->Range(1 << 12, 1 << 24);
+
+void BM_ReadCompressedFile(benchmark::State& state) {
+    const std::string contents = MakeLines(1 << 24);
+    const ScratchFile file("compressed", "");
+    utils::WriteCompressedFile(file.path(), contents, utils::Compression::kBlock);
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(utils::ReadCompressedFile(file.path()));
+    }
+    state.SetBytesProcessed(state.iterations() * contents.size());
+}
+BENCHMARK(BM_ReadCompressedFile)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace cpp_utils
@@ -0,0 +1,190 @@
+#include "benchmarks/instrumentation.h"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace cpp_utils {
+namespace benchmarks {
+namespace {
+
+// Relaxed atomics: the totals only need to be exact once the measured
+// threads have been joined.
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_bytes{0};
+
+void* CountedAlloc(size_t size, size_t alignment) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (size == 0) {
+        size = 1;
+    }
+    if (alignment <= alignof(std::max_align_t)) {
+        return std::malloc(size);
+    }
+    void* p = nullptr;
+    return posix_memalign(&p, alignment, size) == 0 ? p : nullptr;
+}
+
+void* CountedNew(size_t size, size_t alignment = alignof(std::max_align_t)) {
+    void* p = CountedAlloc(size, alignment);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void CountedFree(void* p) {
+    std::free(p);
+}
+
+constexpr uint64_t kEventConfigs[PerfCounters::kEventCount] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+constexpr const char* kEventNames[PerfCounters::kEventCount] = {
+    "cycles",
+    "instructions",
+    "cache_misses",
+    "branch_misses",
+};
+
+}  // namespace
+
+AllocationCounts CurrentAllocationCounts() {
+    AllocationCounts counts;
+    counts.allocations = g_allocations.load(std::memory_order_relaxed);
+    counts.bytes = g_bytes.load(std::memory_order_relaxed);
+    return counts;
+}
+
+PerfCounters::PerfCounters() {
+    for (int event = 0; event < kEventCount; ++event) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = kEventConfigs[event];
+        attr.disabled = 1;
+        attr.inherit = 1;  // Also count threads started while measuring.
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        fds_[event] = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+}
+
+void PerfCounters::Start() {
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+void PerfCounters::Stop(std::array<int64_t, kEventCount>* values) {
+    for (int fd : fds_) {
+        if (fd >= 0) {
+            ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+    for (int event = 0; event < kEventCount; ++event) {
+        (*values)[event] = -1;
+        uint64_t data[3];  // Value, time enabled, time running.
+        if (fds_[event] < 0 || ::read(fds_[event], data, sizeof(data)) != sizeof(data) || data[2] == 0) {
+            continue;
+        }
+        // Extrapolate if the event shared the PMU with others and only ran part of the time.
+        const double scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+        (*values)[event] = static_cast<int64_t>(static_cast<double>(data[0]) * scale);
+    }
+}
+
+void InstrumentedLoop::Start() {
+    start_allocations_ = CurrentAllocationCounts();
+    perf_.Start();
+}
+
+void InstrumentedLoop::Finish() {
+    std::array<int64_t, PerfCounters::kEventCount> values;
+    perf_.Stop(&values);
+    const AllocationCounts end = CurrentAllocationCounts();
+
+    using benchmark::Counter;
+    state_.counters["allocs"] =
+        Counter(static_cast<double>(end.allocations - start_allocations_.allocations), Counter::kAvgIterations);
+    state_.counters["alloc_bytes"] =
+        Counter(static_cast<double>(end.bytes - start_allocations_.bytes), Counter::kAvgIterations);
+    for (int event = 0; event < PerfCounters::kEventCount; ++event) {
+        if (values[event] >= 0) {
+            state_.counters[kEventNames[event]] =
+                Counter(static_cast<double>(values[event]), Counter::kAvgIterations);
+        }
+    }
+    if (values[PerfCounters::kCycles] > 0 && values[PerfCounters::kInstructions] >= 0) {
+        state_.counters["IPC"] = static_cast<double>(values[PerfCounters::kInstructions]) /
+                                 static_cast<double>(values[PerfCounters::kCycles]);
+    }
+}
+
+}  // namespace benchmarks
+}  // namespace cpp_utils
+
+// Counting replacements for every form of the global operator new and delete.
+
+void* operator new(size_t size) { return cpp_utils::benchmarks::CountedNew(size); }
+void* operator new[](size_t size) { return cpp_utils::benchmarks::CountedNew(size); }
+void* operator new(size_t size, std::align_val_t alignment) {
+    return cpp_utils::benchmarks::CountedNew(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return cpp_utils::benchmarks::CountedNew(size, static_cast<size_t>(alignment));
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return cpp_utils::benchmarks::CountedAlloc(size, alignof(std::max_align_t));
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return cpp_utils::benchmarks::CountedAlloc(size, alignof(std::max_align_t));
+}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return cpp_utils::benchmarks::CountedAlloc(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return cpp_utils::benchmarks::CountedAlloc(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept { cpp_utils::benchmarks::CountedFree(p); }
+void operator delete[](void* p) noexcept { cpp_utils::benchmarks::CountedFree(p); }
+void operator delete(void* p, size_t) noexcept { cpp_utils::benchmarks::CountedFree(p); }
+void operator delete[](void* p, size_t) noexcept { cpp_utils::benchmarks::CountedFree(p); }
+void operator delete(void* p, std::align_val_t) noexcept { cpp_utils::benchmarks::CountedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { cpp_utils::benchmarks::CountedFree(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { cpp_utils::benchmarks::CountedFree(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { cpp_utils::benchmarks::CountedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { cpp_utils::benchmarks::CountedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { cpp_utils::benchmarks::CountedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    cpp_utils::benchmarks::CountedFree(p);
+}
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+    cpp_utils::benchmarks::CountedFree(p);
+}
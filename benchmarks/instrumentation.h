@@ -0,0 +1,156 @@
+/**
+ * @file instrumentation.h
+ * @brief Allocation and hardware counters reported alongside benchmark timings.
+ *
+ * Linking instrumentation.cc replaces the global operator new and delete
+ * with versions that count every allocation. Wrapping a benchmark's loop
+ * in Instrument() adds these counters, averaged per iteration:
+ *
+ * - allocs, alloc_bytes: calls to operator new and the bytes they requested.
+ * - cycles, instructions, cache_misses, branch_misses: user-space hardware
+ *   counters from perf_event_open, plus IPC (instructions per cycle).
+ *
+ * @code
+ * void BM_Split(benchmark::State& state) {
+ *     for (auto _ : Instrument(state)) {
+ *         benchmark::DoNotOptimize(utils::Split(text, ','));
+ *     }
+ * }
+ * @endcode
+ *
+ * Only the timed loop is measured. Hardware counters the kernel cannot
+ * provide (no PMU in a VM, perf_event_paranoid too strict) are left out of
+ * the report. Counters follow threads started inside the loop, while
+ * allocations are counted process-wide.
+ */
+
+#ifndef CPP_UTILS_LIB_BENCHMARKS_INSTRUMENTATION_H_
+#define CPP_UTILS_LIB_BENCHMARKS_INSTRUMENTATION_H_
+
+#include <array>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+namespace cpp_utils {
+namespace benchmarks {
+
+/**
+ * @brief Running totals of the counting operator new.
+ */
+struct AllocationCounts {
+    uint64_t allocations = 0;  // Calls to any operator new.
+    uint64_t bytes = 0;        // Bytes requested from operator new.
+};
+
+/**
+ * @brief Reads the allocation totals since the process started.
+ * @return The current totals.
+ */
+AllocationCounts CurrentAllocationCounts();
+
+/**
+ * @brief A group of user-space hardware counters for the calling thread.
+ */
+class PerfCounters {
+public:
+    /** @brief The events counted, in report order. */
+    enum Event { kCycles, kInstructions, kCacheMisses, kBranchMisses, kEventCount };
+
+    /**
+     * @brief Opens every event the kernel supports; the rest are skipped.
+     */
+    PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters();
+
+    /**
+     * @brief Resets and starts the counters.
+     */
+    void Start();
+
+    /**
+     * @brief Stops the counters and reads them.
+     * @param values Receives each event's count, scaled up if the kernel
+     *               multiplexed it; -1 for events that could not be opened.
+     */
+    void Stop(std::array<int64_t, kEventCount>* values);
+
+private:
+    std::array<int, kEventCount> fds_;
+};
+
+/**
+ * @brief A benchmark loop that measures the counters while it runs.
+ *
+ * Iterating it drives the underlying benchmark::State exactly like
+ * `for (auto _ : state)`. The counters start once the state's timer has
+ * started and stop once it has stopped, and the results are stored in
+ * state.counters.
+ */
+class InstrumentedLoop {
+public:
+    class Iterator {
+    public:
+        Iterator(benchmark::State::StateIterator it, InstrumentedLoop* loop) : it_(it), loop_(loop) {}
+
+        benchmark::State::StateIterator::Value operator*() const { return *it_; }
+
+        Iterator& operator++() {
+            ++it_;
+            return *this;
+        }
+
+        bool operator!=(const Iterator& end) const {
+            if (it_ != end.it_) {
+                return true;
+            }
+            loop_->Finish();
+            return false;
+        }
+
+    private:
+        benchmark::State::StateIterator it_;
+        InstrumentedLoop* loop_;
+    };
+
+    explicit InstrumentedLoop(benchmark::State& state) : state_(state) {}
+
+    InstrumentedLoop(const InstrumentedLoop&) = delete;
+    InstrumentedLoop& operator=(const InstrumentedLoop&) = delete;
+
+    Iterator begin() { return Iterator(state_.begin(), this); }
+
+    // The range-for calls end() once, after begin(); the state starts its
+    // timer here, so the counters start right after it.
+    Iterator end() {
+        Iterator it(state_.end(), this);
+        Start();
+        return it;
+    }
+
+private:
+    void Start();
+    void Finish();
+
+    benchmark::State& state_;
+    PerfCounters perf_;
+    AllocationCounts start_allocations_;
+};
+
+/**
+ * @brief Wraps a benchmark's state so its loop reports allocation and hardware counters.
+ * @param state The benchmark state.
+ * @return The loop to iterate instead of the state.
+ */
+inline InstrumentedLoop Instrument(benchmark::State& state) {
+    return InstrumentedLoop(state);
+}
+
+}  // namespace benchmarks
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_BENCHMARKS_INSTRUMENTATION_H_
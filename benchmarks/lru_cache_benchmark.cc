@@ -0,0 +1,173 @@
+/**
+ * @file lru_cache_benchmark.cc
+ * @brief Benchmarks for LRUCache hits, misses, evictions and snapshots.
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/instrumentation.h"
+#include "src/data_structures/lru_cache.h"
+#include "src/data_structures/tiered_cache.h"
+
+namespace cpp_utils {
+namespace benchmarks {
+namespace {
+
+using data_structures::LRUCache;
+
+// Keys drawn uniformly from [0, range), in a fixed order so runs are comparable.
+std::vector<int64_t> MakeKeys(size_t count, int64_t range) {
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int64_t> key(0, range - 1);
+    std::vector<int64_t> keys(count);
+    for (auto& k : keys) {
+        k = key(rng);
+    }
+    return keys;
+}
+
+LRUCache<int64_t, std::string> MakeFullCache(size_t capacity) {
+    LRUCache<int64_t, std::string> cache(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+        cache.Put(static_cast<int64_t>(i), "value" + std::to_string(i));
+    }
+    return cache;
+}
+
+void BM_LRUCacheGetHit(benchmark::State& state) {
+    const size_t capacity = static_cast<size_t>(state.range(0));
+    auto cache = MakeFullCache(capacity);
+    const auto keys = MakeKeys(4096, static_cast<int64_t>(capacity));
+    for (auto _ : Instrument(state)) {
+        for (int64_t key : keys) {
+            benchmark::DoNotOptimize(cache.Get(key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_LRUCacheGetHit)->Range(1 << 10, 1 << 20);
+
+void BM_LRUCacheGetMiss(benchmark::State& state) {
+    const size_t capacity = static_cast<size_t>(state.range(0));
+    auto cache = MakeFullCache(capacity);
+    auto keys = MakeKeys(4096, static_cast<int64_t>(capacity));
+    for (auto& key : keys) {
+        key += static_cast<int64_t>(capacity);
+    }
+    for (auto _ : Instrument(state)) {
+        for (int64_t key : keys) {
+            benchmark::DoNotOptimize(cache.Get(key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_LRUCacheGetMiss)->Range(1 << 10, 1 << 20);
+
+// Every Put inserts a new key into a full cache, so each one evicts.
+void BM_LRUCachePutEvict(benchmark::State& state) {
+    const size_t capacity = static_cast<size_t>(state.range(0));
+    auto cache = MakeFullCache(capacity);
+    int64_t next = static_cast<int64_t>(capacity);
+    for (auto _ : Instrument(state)) {
+        cache.Put(next++, "value");
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LRUCachePutEvict)->Range(1 << 10, 1 << 20);
+
+void BM_LRUCachePutUpdate(benchmark::State& state) {
+    const size_t capacity = static_cast<size_t>(state.range(0));
+    auto cache = MakeFullCache(capacity);
+    const auto keys = MakeKeys(4096, static_cast<int64_t>(capacity));
+    for (auto _ : Instrument(state)) {
+        for (int64_t key : keys) {
+            cache.Put(key, "updated");
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_LRUCachePutUpdate)->Range(1 << 10, 1 << 20);
+
+// A read-through workload over a key space twice the capacity: about half
+// the lookups miss and are filled with a Put that evicts.
+void BM_LRUCacheReadThrough(benchmark::State& state) {
+    const size_t capacity = static_cast<size_t>(state.range(0));
+    auto cache = MakeFullCache(capacity);
+    const auto keys = MakeKeys(4096, 2 * static_cast<int64_t>(capacity));
+    for (auto _ : Instrument(state)) {
+        for (int64_t key : keys) {
+            if (!cache.Get(key)) {
+                cache.Put(key, "filled");
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_LRUCacheReadThrough)->Range(1 << 10, 1 << 20);
+
+void BM_LRUCacheSaveSnapshot(benchmark::State& state) {
+    const size_t capacity = static_cast<size_t>(state.range(0));
+    const auto cache = MakeFullCache(capacity);
+    const auto path = std::filesystem::temp_directory_path() / "cpp_utils_lru_cache_benchmark.snap";
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(cache.SaveSnapshot(path));
+    }
+    state.SetItemsProcessed(state.iterations() * capacity);
+    state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(path));
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_LRUCacheSaveSnapshot)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+
+void BM_LRUCacheLoadSnapshot(benchmark::State& state) {
+    const size_t capacity = static_cast<size_t>(state.range(0));
+    const auto path = std::filesystem::temp_directory_path() / "cpp_utils_lru_cache_benchmark.snap";
+    MakeFullCache(capacity).SaveSnapshot(path);
+    LRUCache<int64_t, std::string> cache(capacity);
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(cache.LoadSnapshot(path));
+    }
+    state.SetItemsProcessed(state.iterations() * capacity);
+    state.SetBytesProcessed(state.iterations() * std::filesystem::file_size(path));
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_LRUCacheLoadSnapshot)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+
+// Lookups that miss the memory tier and are served by the disk tier. Keys
+// are visited in a scrambled cycle over every entry, continuing across
+// iterations, so a key only comes back after all the others have pushed
+// it out of memory.
+void BM_TieredCacheDiskHit(benchmark::State& state) {
+    constexpr size_t kMemoryEntries = 1024;
+    constexpr size_t kLookups = 1024;
+    // Odd, so stepping by it modulo a power of two visits every key once per cycle.
+    constexpr uint64_t kStride = 0x9e3779b97f4a7c15;
+    const auto directory = std::filesystem::temp_directory_path() / "cpp_utils_tiered_cache_benchmark";
+    std::filesystem::remove_all(directory);
+    {
+        auto cache = data_structures::TieredCache<int64_t, std::string>::Open(kMemoryEntries, directory);
+        const uint64_t entries = static_cast<uint64_t>(state.range(0));  // A power of two above kMemoryEntries.
+        for (uint64_t i = 0; i < entries; ++i) {
+            cache->Put(static_cast<int64_t>(i), std::string(100, 'v'));
+        }
+        uint64_t key = 0;
+        for (auto _ : Instrument(state)) {
+            for (size_t i = 0; i < kLookups; ++i) {
+                key = (key + kStride) & (entries - 1);
+                benchmark::DoNotOptimize(cache->Get(static_cast<int64_t>(key)));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * kLookups);
+    }
+    std::filesystem::remove_all(directory);
+}
+BENCHMARK(BM_TieredCacheDiskHit)->Arg(1 << 14)->Arg(1 << 17);
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace cpp_utils
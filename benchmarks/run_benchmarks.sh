@@ -0,0 +1,27 @@
+#!/bin/bash
+# Runs every benchmark binary in //benchmarks and saves the results as JSON.
+#
+# Usage: benchmarks/run_benchmarks.sh [OUTPUT_DIR] [BENCHMARK_FLAGS...]
+#
+# OUTPUT_DIR defaults to benchmark_results/<short commit hash>. Extra flags
+# are passed to every binary, e.g. --benchmark_filter=Split or
+# --benchmark_repetitions=5. Compare two runs with benchmarks/compare.py.
+set -euo pipefail
+
+cd "$(dirname "$0")/.."
+output_dir="${1:-benchmark_results/$(git rev-parse --short HEAD)}"
+shift || true
+mkdir -p "${output_dir}"
+output_dir="$(cd "${output_dir}" && pwd)"
+
+targets=$(bazel query 'kind(cc_binary, //benchmarks:*)' 2>/dev/null)
+bazel build -c opt ${targets}
+for target in ${targets}; do
+    name="${target##*:}"
+    echo "== ${name}"
+    "bazel-bin/benchmarks/${name}" \
+        --benchmark_out="${output_dir}/${name}.json" \
+        --benchmark_out_format=json \
+        "$@"
+done
+echo "Results written to ${output_dir}"
@@ -0,0 +1,92 @@
+/**
+ * @file string_search_benchmark.cc
+ * @brief Benchmarks for the substring search kernels against the standard library.
+ */
+
+#include <random>
+#include <string>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/instrumentation.h"
+#include "src/utils/string_searcher.h"
+#include "src/utils/string_utils.h"
+
+namespace cpp_utils {
+namespace benchmarks {
+namespace {
+
+// Natural-language-like text over a small alphabet, so first/last byte
+// candidates are frequent enough to exercise verification.
+std::string MakeHaystack(size_t size) {
+    std::mt19937 rng(5);
+    const std::string alphabet = "etaoinshrdlu ";
+    std::string text(size, ' ');
+    for (char& c : text) {
+        c = alphabet[rng() % alphabet.size()];
+    }
+    return text;
+}
+
+// The needle starts with the most common byte and is placed at the very
+// end, so the whole haystack is scanned past many false first-byte hits.
+std::pair<std::string, std::string> MakeCase(size_t haystack_size, size_t needle_size) {
+    std::string haystack = MakeHaystack(haystack_size);
+    std::string needle(needle_size, 'e');
+    for (size_t i = 1; i < needle_size; ++i) {
+        needle[i] = "xyzqj"[i % 5];
+    }
+    haystack.replace(haystack.size() - needle.size(), needle.size(), needle);
+    return {haystack, needle};
+}
+
+void SearchArgs(benchmark::internal::Benchmark* b) {
+    for (int64_t haystack : {256, 4096, 1 << 20}) {
+        for (int64_t needle : {1, 2, 4, 8, 16, 64}) {
+            b->Args({haystack, needle});
+        }
+    }
+}
+
+void BM_StdFind(benchmark::State& state) {
+    const auto [haystack, needle] = MakeCase(state.range(0), state.range(1));
+    const std::string_view view(haystack);
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(view.find(needle));
+    }
+    state.SetBytesProcessed(state.iterations() * haystack.size());
+}
+BENCHMARK(BM_StdFind)->Apply(SearchArgs);
+
+void BM_StringSearcher(benchmark::State& state) {
+    const auto [haystack, needle] = MakeCase(state.range(0), state.range(1));
+    const utils::StringSearcher searcher(needle);
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(searcher.Find(haystack));
+    }
+    state.SetBytesProcessed(state.iterations() * haystack.size());
+}
+BENCHMARK(BM_StringSearcher)->Apply(SearchArgs);
+
+void BM_StartsWith(benchmark::State& state) {
+    const std::string text = MakeHaystack(state.range(0));
+    const std::string prefix = text.substr(0, state.range(0) / 2);
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(utils::StartsWith(text, prefix));
+    }
+}
+BENCHMARK(BM_StartsWith)->Range(8, 4096);
+
+void BM_EndsWith(benchmark::State& state) {
+    const std::string text = MakeHaystack(state.range(0));
+    const std::string suffix = text.substr(state.range(0) / 2);
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(utils::EndsWith(text, suffix));
+    }
+}
+BENCHMARK(BM_EndsWith)->Range(8, 4096);
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace cpp_utils
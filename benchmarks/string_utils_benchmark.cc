@@ -0,0 +1,484 @@
+/**
+ * @file string_utils_benchmark.cc
+ * @brief Benchmarks for the string utility functions.
+ *
+ * Throughput benchmarks report bytes processed, so Google Benchmark prints
+ * them as GB/s next to the wall time.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/instrumentation.h"
+#include "src/utils/arena.h"
+#include "src/utils/multi_replacer.h"
+#include "src/utils/string_builder.h"
+#include "src/utils/string_simd.h"
+#include "src/utils/string_utils.h"
+
+namespace cpp_utils {
+namespace benchmarks {
+namespace {
+
+// Builds delimited text with fields of 1..2*avg_field bytes.
+std::string MakeDelimitedText(size_t size, size_t avg_field, char delimiter) {
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<size_t> field_length(1, 2 * avg_field);
+    std::uniform_int_distribution<int> letter('a', 'z');
+    std::string text;
+    text.reserve(size);
+    while (text.size() < size) {
+        const size_t n = field_length(rng);
+        for (size_t i = 0; i < n; ++i) {
+            text.push_back(static_cast<char>(letter(rng)));
+        }
+        text.push_back(delimiter);
+    }
+    text.resize(size);
+    return text;
+}
+
+// The byte-at-a-time split the library used before string_view tokens.
+std::vector<std::string> LegacySplit(std::string_view input, char delimiter) {
+    std::vector<std::string> result;
+    if (input.empty()) {
+        return result;
+    }
+    std::string current;
+    for (char c : input) {
+        if (c == delimiter) {
+            result.push_back(current);
+            current.clear();
+        } else {
+            current += c;
+        }
+    }
+    result.push_back(current);
+    return result;
+}
+
+void BM_LegacySplit(benchmark::State& state) {
+    const std::string text = MakeDelimitedText(state.range(0), 16, ',');
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(LegacySplit(text, ','));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_LegacySplit)->Range(1 << 10, 1 << 20);
+
+void BM_Split(benchmark::State& state) {
+    const std::string text = MakeDelimitedText(state.range(0), 16, ',');
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(utils::Split(text, ','));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_Split)->Range(1 << 10, 1 << 20);
+
+void BM_SplitViewReusedBuffer(benchmark::State& state) {
+    const std::string text = MakeDelimitedText(state.range(0), 16, ',');
+    std::vector<std::string_view> pieces;
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(utils::SplitView(text, ',', &pieces));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_SplitViewReusedBuffer)->Range(1 << 10, 1 << 20);
+
+void BM_SplitLazy(benchmark::State& state) {
+    const std::string text = MakeDelimitedText(state.range(0), 16, ',');
+    for (auto _ : Instrument(state)) {
+        size_t count = 0;
+        for (std::string_view piece : utils::SplitLazy(text, ',')) {
+            benchmark::DoNotOptimize(piece.data());
+            ++count;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_SplitLazy)->Range(1 << 10, 1 << 20);
+
+// Per-line parsing of 20 fields, with and without an arena reset per line.
+void BM_SplitLinesHeap(benchmark::State& state) {
+    const auto lines = utils::Split(MakeDelimitedText(1 << 16, 400, '\n'), '\n');
+    for (auto _ : Instrument(state)) {
+        for (const auto& line : lines) {
+            benchmark::DoNotOptimize(utils::Split(line, 'a'));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * lines.size());
+}
+BENCHMARK(BM_SplitLinesHeap);
+
+void BM_SplitLinesArena(benchmark::State& state) {
+    const auto lines = utils::Split(MakeDelimitedText(1 << 16, 400, '\n'), '\n');
+    utils::Arena arena;
+    for (auto _ : Instrument(state)) {
+        for (const auto& line : lines) {
+            benchmark::DoNotOptimize(utils::Split(line, 'a', &arena));
+            arena.Reset();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * lines.size());
+}
+BENCHMARK(BM_SplitLinesArena);
+
+void BM_SplitAny(benchmark::State& state) {
+    const std::string text = MakeDelimitedText(state.range(0), 16, ';');
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(utils::SplitAny(text, ",;\t"));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_SplitAny)->Range(1 << 10, 1 << 20);
+
+void BM_SplitCsv(benchmark::State& state) {
+    std::string line;
+    while (line.size() < static_cast<size_t>(state.range(0))) {
+        line += R"(plain,"quoted, field","with ""escapes""",)";
+    }
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(utils::SplitCsv(line));
+    }
+    state.SetBytesProcessed(state.iterations() * line.size());
+}
+BENCHMARK(BM_SplitCsv)->Range(1 << 10, 1 << 16);
+
+// The ostringstream-based join the library used before pre-sizing.
+std::string LegacyJoin(const std::vector<std::string>& strings, std::string_view delimiter) {
+    std::ostringstream result;
+    bool first = true;
+    for (const auto& s : strings) {
+        if (!first) {
+            result << delimiter;
+        }
+        result << s;
+        first = false;
+    }
+    return result.str();
+}
+
+void BM_LegacyJoin(benchmark::State& state) {
+    const auto pieces = utils::Split(MakeDelimitedText(state.range(0), 16, ','), ',');
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(LegacyJoin(pieces, ", "));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LegacyJoin)->Range(1 << 10, 1 << 20);
+
+void BM_Join(benchmark::State& state) {
+    const auto pieces = utils::Split(MakeDelimitedText(state.range(0), 16, ','), ',');
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(utils::Join(pieces, ", "));
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Join)->Range(1 << 10, 1 << 20);
+
+void BM_StringBuilder(benchmark::State& state) {
+    for (auto _ : Instrument(state)) {
+        utils::StringBuilder builder;
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            builder.Append("key=").AppendInt(i).Append(' ');
+        }
+        benchmark::DoNotOptimize(builder.View().data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StringBuilder)->Range(8, 1 << 12);
+
+// The locale-aware per-byte lowering the library used before the ASCII kernels.
+void BM_LegacyToLower(benchmark::State& state) {
+    const std::string text = MakeDelimitedText(state.range(0), 16, ' ');
+    for (auto _ : Instrument(state)) {
+        std::string result(text);
+        std::transform(result.begin(), result.end(), result.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_LegacyToLower)->Range(1 << 10, 1 << 20);
+
+void BM_ToLower(benchmark::State& state) {
+    const std::string text = MakeDelimitedText(state.range(0), 16, ' ');
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(utils::ToLower(text));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_ToLower)->Range(1 << 10, 1 << 20);
+
+void BM_ToUpper(benchmark::State& state) {
+    const std::string text = MakeDelimitedText(state.range(0), 16, ' ');
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(utils::ToUpper(text));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_ToUpper)->Range(1 << 10, 1 << 20);
+
+void BM_ToLowerInPlace(benchmark::State& state) {
+    std::string text = MakeDelimitedText(state.range(0), 16, ' ');
+    for (auto _ : Instrument(state)) {
+        utils::ToLowerInPlace(&text);
+        benchmark::DoNotOptimize(text.data());
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_ToLowerInPlace)->Range(1 << 10, 1 << 20);
+
+void BM_ToUpperInPlace(benchmark::State& state) {
+    std::string text = MakeDelimitedText(state.range(0), 16, ' ');
+    for (auto _ : Instrument(state)) {
+        utils::ToUpperInPlace(&text);
+        benchmark::DoNotOptimize(text.data());
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_ToUpperInPlace)->Range(1 << 10, 1 << 20);
+
+void BM_Trim(benchmark::State& state) {
+    const std::string text = "   " + MakeDelimitedText(64, 16, ' ') + "\t\n";
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(utils::Trim(text));
+    }
+}
+BENCHMARK(BM_Trim);
+
+void BM_TrimView(benchmark::State& state) {
+    const std::string text = "   " + MakeDelimitedText(64, 16, ' ') + "\t\n";
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(utils::TrimView(text));
+    }
+}
+BENCHMARK(BM_TrimView);
+
+// Prefix and suffix checks over a batch of paths, half of which match.
+void BM_StartsWithEndsWith(benchmark::State& state) {
+    const auto names = utils::Split(MakeDelimitedText(1 << 16, 24, ','), ',');
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < names.size(); ++i) {
+        paths.push_back((i % 2 ? "/var/log/" : "/tmp/") + names[i] + (i % 2 ? ".log" : ".txt"));
+    }
+    for (auto _ : Instrument(state)) {
+        size_t matches = 0;
+        for (const auto& path : paths) {
+            matches += utils::StartsWith(path, "/var/log/") + utils::EndsWith(path, ".log");
+        }
+        benchmark::DoNotOptimize(matches);
+    }
+    state.SetItemsProcessed(state.iterations() * paths.size());
+}
+BENCHMARK(BM_StartsWithEndsWith);
+
+void BM_ReplaceAll(benchmark::State& state) {
+    const std::string text = MakeDelimitedText(state.range(0), 16, ',');
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(utils::Replace(text, ",", ", ", true));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_ReplaceAll)->Range(1 << 10, 1 << 20);
+
+void BM_ReplaceFirst(benchmark::State& state) {
+    const std::string text = MakeDelimitedText(state.range(0), 16, ',');
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(utils::Replace(text, ",", ", "));
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_ReplaceFirst)->Range(1 << 10, 1 << 20);
+
+// Redacting many tokens per line: one Replace pass per token vs. one compiled pass.
+std::vector<std::pair<std::string, std::string>> MakeRedactions(size_t count) {
+    std::vector<std::pair<std::string, std::string>> redactions;
+    for (size_t i = 0; i < count; ++i) {
+        redactions.emplace_back("secret" + std::to_string(i), "***");
+    }
+    return redactions;
+}
+
+std::string MakeLogLine(size_t tokens) {
+    std::string line;
+    for (size_t i = 0; i < 20; ++i) {
+        line += "field" + std::to_string(i) + "=secret" + std::to_string(i * 7 % tokens) + " ";
+    }
+    return line;
+}
+
+void BM_RedactWithReplace(benchmark::State& state) {
+    const auto redactions = MakeRedactions(state.range(0));
+    const std::string line = MakeLogLine(state.range(0));
+    for (auto _ : Instrument(state)) {
+        std::string result = line;
+        for (const auto& [from, to] : redactions) {
+            result = utils::Replace(result, from, to, true);
+        }
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(state.iterations() * line.size());
+}
+BENCHMARK(BM_RedactWithReplace)->Arg(10)->Arg(100)->Arg(500);
+
+void BM_RedactWithMultiReplacer(benchmark::State& state) {
+    const utils::MultiReplacer replacer(MakeRedactions(state.range(0)));
+    const std::string line = MakeLogLine(state.range(0));
+    std::string result;
+    for (auto _ : Instrument(state)) {
+        replacer.Apply(line, &result);
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetBytesProcessed(state.iterations() * line.size());
+}
+BENCHMARK(BM_RedactWithMultiReplacer)->Arg(10)->Arg(100)->Arg(500);
+
+std::vector<std::string> MakeNumbers(size_t count, bool fractional) {
+    std::mt19937 rng(99);
+    std::uniform_int_distribution<int64_t> value(-1000000000, 1000000000);
+    std::vector<std::string> numbers;
+    for (size_t i = 0; i < count; ++i) {
+        numbers.push_back(fractional ? std::to_string(value(rng) / 1000.0) : std::to_string(value(rng)));
+    }
+    return numbers;
+}
+
+void BM_LegacyStoi(benchmark::State& state) {
+    const auto numbers = MakeNumbers(1024, false);
+    for (auto _ : Instrument(state)) {
+        for (const auto& n : numbers) {
+            benchmark::DoNotOptimize(std::stoi(std::string(utils::Trim(n))));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numbers.size());
+}
+BENCHMARK(BM_LegacyStoi);
+
+void BM_ToInt(benchmark::State& state) {
+    const auto numbers = MakeNumbers(1024, false);
+    for (auto _ : Instrument(state)) {
+        for (const auto& n : numbers) {
+            benchmark::DoNotOptimize(utils::ToInt(n));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numbers.size());
+}
+BENCHMARK(BM_ToInt);
+
+void BM_ToInt64(benchmark::State& state) {
+    const auto numbers = MakeNumbers(1024, false);
+    for (auto _ : Instrument(state)) {
+        for (const auto& n : numbers) {
+            benchmark::DoNotOptimize(utils::ToInt64(n));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numbers.size());
+}
+BENCHMARK(BM_ToInt64);
+
+void BM_ToUint64(benchmark::State& state) {
+    auto numbers = MakeNumbers(1024, false);
+    for (auto& n : numbers) {
+        if (n[0] == '-') {
+            n.erase(0, 1);
+        }
+    }
+    for (auto _ : Instrument(state)) {
+        for (const auto& n : numbers) {
+            benchmark::DoNotOptimize(utils::ToUint64(n));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numbers.size());
+}
+BENCHMARK(BM_ToUint64);
+
+void BM_LegacyStod(benchmark::State& state) {
+    const auto numbers = MakeNumbers(1024, true);
+    for (auto _ : Instrument(state)) {
+        for (const auto& n : numbers) {
+            benchmark::DoNotOptimize(std::stod(std::string(utils::Trim(n))));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numbers.size());
+}
+BENCHMARK(BM_LegacyStod);
+
+void BM_ToDouble(benchmark::State& state) {
+    const auto numbers = MakeNumbers(1024, true);
+    for (auto _ : Instrument(state)) {
+        for (const auto& n : numbers) {
+            benchmark::DoNotOptimize(utils::ToDouble(n));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numbers.size());
+}
+BENCHMARK(BM_ToDouble);
+
+void BM_ToFloat(benchmark::State& state) {
+    const auto numbers = MakeNumbers(1024, true);
+    for (auto _ : Instrument(state)) {
+        for (const auto& n : numbers) {
+            benchmark::DoNotOptimize(utils::ToFloat(n));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numbers.size());
+}
+BENCHMARK(BM_ToFloat);
+
+void BM_ToInt64Column(benchmark::State& state) {
+    const auto numbers = MakeNumbers(1024, false);
+    const std::vector<std::string_view> column(numbers.begin(), numbers.end());
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(utils::ToInt64Column(column));
+    }
+    state.SetItemsProcessed(state.iterations() * column.size());
+}
+BENCHMARK(BM_ToInt64Column);
+
+void BM_ToDoubleColumn(benchmark::State& state) {
+    const auto numbers = MakeNumbers(1024, true);
+    const std::vector<std::string_view> column(numbers.begin(), numbers.end());
+    for (auto _ : Instrument(state)) {
+        benchmark::DoNotOptimize(utils::ToDoubleColumn(column));
+    }
+    state.SetItemsProcessed(state.iterations() * column.size());
+}
+BENCHMARK(BM_ToDoubleColumn);
+
+// Raw delimiter scanning over long fields, where the kernel choice dominates.
+template <bool kScalar>
+void BM_FindFirstOf(benchmark::State& state) {
+    const std::string text = MakeDelimitedText(1 << 20, state.range(0), ',');
+    const utils::internal::ByteSet set(",;");
+    for (auto _ : Instrument(state)) {
+        size_t count = 0;
+        size_t pos = 0;
+        while (true) {
+            pos = kScalar ? utils::internal::FindFirstOfScalar(text, pos, set)
+                          : utils::internal::FindFirstOf(text, pos, set);
+            if (pos == std::string_view::npos) {
+                break;
+            }
+            ++count;
+            ++pos;
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(state.iterations() * text.size());
+    state.SetLabel(kScalar ? "scalar" : utils::internal::SelectedKernelName());
+}
+BENCHMARK_TEMPLATE(BM_FindFirstOf, true)->Arg(8)->Arg(64)->Arg(512);
+BENCHMARK_TEMPLATE(BM_FindFirstOf, false)->Arg(8)->Arg(64)->Arg(512);
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace cpp_utils
@@ -0,0 +1,100 @@
+/**
+ * @file thread_safe_queue_benchmark.cc
+ * @brief Benchmarks for ThreadSafeQueue with one or more producers and consumers.
+ */
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/instrumentation.h"
+#include "src/data_structures/thread_safe_queue.h"
+
+namespace cpp_utils {
+namespace benchmarks {
+namespace {
+
+using data_structures::ThreadSafeQueue;
+
+// Uncontended cost of a push followed by a pop.
+void BM_QueuePushPop(benchmark::State& state) {
+    ThreadSafeQueue<int64_t> queue;
+    int64_t value = 0;
+    for (auto _ : Instrument(state)) {
+        queue.Push(value);
+        benchmark::DoNotOptimize(queue.TryPop(value));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QueuePushPop);
+
+// Pushes a burst, then drains it, so the queue grows and shrinks.
+void BM_QueueBurst(benchmark::State& state) {
+    ThreadSafeQueue<int64_t> queue;
+    const int64_t burst = state.range(0);
+    int64_t value = 0;
+    for (auto _ : Instrument(state)) {
+        for (int64_t i = 0; i < burst; ++i) {
+            queue.Push(i);
+        }
+        while (queue.TryPop(value)) {
+            benchmark::DoNotOptimize(value);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * burst);
+}
+BENCHMARK(BM_QueueBurst)->Range(64, 1 << 16);
+
+// Moves kItems items from range(0) producers to range(1) consumers. Each
+// consumer stops at a sentinel pushed once all producers are done.
+void BM_QueueProducersConsumers(benchmark::State& state) {
+    constexpr int64_t kItems = 1 << 16;
+    const int producers = static_cast<int>(state.range(0));
+    const int consumers = static_cast<int>(state.range(1));
+    for (auto _ : Instrument(state)) {
+        ThreadSafeQueue<int64_t> queue;
+        std::vector<std::thread> threads;
+        for (int c = 0; c < consumers; ++c) {
+            threads.emplace_back([&queue] {
+                int64_t sum = 0;
+                while (true) {
+                    const int64_t value = queue.Pop();
+                    if (value < 0) {
+                        break;
+                    }
+                    sum += value;
+                }
+                benchmark::DoNotOptimize(sum);
+            });
+        }
+        std::vector<std::thread> writers;
+        for (int p = 0; p < producers; ++p) {
+            writers.emplace_back([&queue, p, producers] {
+                for (int64_t i = p; i < kItems; i += producers) {
+                    queue.Push(i);
+                }
+            });
+        }
+        for (auto& writer : writers) {
+            writer.join();
+        }
+        for (int c = 0; c < consumers; ++c) {
+            queue.Push(-1);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kItems);
+}
+BENCHMARK(BM_QueueProducersConsumers)
+    ->ArgNames({"producers", "consumers"})
+    ->ArgsProduct({{1, 2, 4, 8}, {1, 2, 4, 8}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace benchmarks
+}  // namespace cpp_utils
@@ -6,11 +6,22 @@
 #ifndef CPP_UTILS_LIB_SRC_DATA_STRUCTURES_LRU_CACHE_H_
 #define CPP_UTILS_LIB_SRC_DATA_STRUCTURES_LRU_CACHE_H_
 
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <iterator>
 #include <list>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 
+#include "src/utils/file_utils.h"
+#include "src/utils/mapped_file.h"
+#include "src/utils/serializer.h"
+
 namespace cpp_utils {
 namespace data_structures {
 
@@ -22,6 +33,11 @@ namespace data_structures {
 template <typename Key, typename Value>
 class LRUCache {
 public:
+    /**
+     * @brief Called with each entry the cache evicts to make room.
+     */
+    using EvictionCallback = std::function<void(const Key& key, Value&& value)>;
+
     /**
      * @brief Constructs an LRU cache with a specified capacity.
      * @param capacity The maximum number of elements in the cache.
@@ -52,7 +68,11 @@ public:
             if (cache_map_.size() >= capacity_) {
                 // Remove the least recently used element
                 const Key& lru_key = usage_list_.back();
-                cache_map_.erase(lru_key);
+                auto lru = cache_map_.find(lru_key);
+                if (eviction_callback_) {
+                    eviction_callback_(lru_key, std::move(lru->second.value));
+                }
+                cache_map_.erase(lru);
                 usage_list_.pop_back();
             }
             
@@ -134,7 +154,123 @@ public:
         usage_list_.clear();
     }
 
+    /**
+     * @brief Sets the function called with each evicted entry, e.g. to spill it elsewhere.
+     *
+     * Entries removed through Erase() or Clear() are not reported.
+     *
+     * @param callback The callback, or an empty function to disable it.
+     */
+    void SetEvictionCallback(EvictionCallback callback) {
+        eviction_callback_ = std::move(callback);
+    }
+
+    /**
+     * @brief Visits every entry from most to least recently used without changing the order.
+     * @param fn Called as fn(key, value); may modify the value.
+     */
+    template <typename Fn>
+    void ForEach(Fn fn) {
+        for (const Key& key : usage_list_) {
+            fn(key, cache_map_.find(key)->second.value);
+        }
+    }
+
+    /**
+     * @brief Visits every entry from most to least recently used without changing the order.
+     * @param fn Called as fn(key, value).
+     */
+    template <typename Fn>
+    void ForEach(Fn fn) const {
+        for (const Key& key : usage_list_) {
+            fn(key, static_cast<const Value&>(cache_map_.find(key)->second.value));
+        }
+    }
+
+    /**
+     * @brief Writes every entry to a file, from most to least recently used.
+     *
+     * The snapshot is a short header (magic and entry count) followed by
+     * each key and value as encoded by the serializers; see
+     * utils::Serializer. The file is replaced atomically, so a crash never
+     * leaves a partial snapshot behind.
+     *
+     * @tparam KeySerializer Encodes keys.
+     * @tparam ValueSerializer Encodes values.
+     * @param filename The path to the snapshot file.
+     * @return True on success, false otherwise.
+     */
+    template <typename KeySerializer = utils::Serializer<Key>,
+              typename ValueSerializer = utils::Serializer<Value>>
+    bool SaveSnapshot(const std::filesystem::path& filename) const {
+        std::string data(kSnapshotMagic);
+        utils::Serializer<uint64_t>::Encode(cache_map_.size(), &data);
+        for (const Key& key : usage_list_) {
+            KeySerializer::Encode(key, &data);
+            ValueSerializer::Encode(cache_map_.find(key)->second.value, &data);
+        }
+        utils::WriteOptions options;
+        options.atomic = true;
+        return utils::WriteFile(filename, data, options);
+    }
+
+    /**
+     * @brief Replaces the contents with a snapshot written by SaveSnapshot().
+     *
+     * The file is memory-mapped and decoded in one sequential pass, with the
+     * index sized up front. The recency order is restored; if the snapshot
+     * holds more entries than the capacity, only the most recent ones are
+     * kept. No eviction callbacks are made.
+     *
+     * @tparam KeySerializer Decodes keys; must match the one used to save.
+     * @tparam ValueSerializer Decodes values; must match the one used to save.
+     * @param filename The path to the snapshot file.
+     * @return True on success; false if the file is missing or malformed, in which case the cache is left empty.
+     */
+    template <typename KeySerializer = utils::Serializer<Key>,
+              typename ValueSerializer = utils::Serializer<Value>>
+    bool LoadSnapshot(const std::filesystem::path& filename) {
+        Clear();
+        utils::MapOptions map_options;
+        map_options.will_need = true;
+        auto file = utils::MappedFile::Open(filename, map_options);
+        if (!file) {
+            return false;
+        }
+        std::string_view input = file->View();
+        uint64_t count = 0;
+        if (input.substr(0, kSnapshotMagic.size()) != kSnapshotMagic) {
+            return false;
+        }
+        input.remove_prefix(kSnapshotMagic.size());
+        if (!utils::Serializer<uint64_t>::Decode(&input, &count)) {
+            return false;
+        }
+
+        const size_t keep = static_cast<size_t>(std::min<uint64_t>(count, capacity_));
+        cache_map_.reserve(keep);
+        // Entries are stored most recent first, so each one goes to the back.
+        for (size_t i = 0; i < keep; ++i) {
+            usage_list_.emplace_back();
+            Key& key = usage_list_.back();
+            if (!KeySerializer::Decode(&input, &key)) {
+                Clear();
+                return false;
+            }
+            auto [it, inserted] = cache_map_.try_emplace(key);
+            if (!inserted || !ValueSerializer::Decode(&input, &it->second.value)) {
+                Clear();
+                return false;
+            }
+            it->second.list_iterator = std::prev(usage_list_.end());
+        }
+        return true;
+    }
+
 private:
+    /** @brief Identifies the snapshot format and its version. */
+    static constexpr std::string_view kSnapshotMagic = "LRUSNAP1";
+
     struct CacheEntry {
         Value value;
         typename std::list<Key>::iterator list_iterator;
@@ -143,6 +279,7 @@ private:
     size_t capacity_;
     std::list<Key> usage_list_;  // Most recently used items at the front
     std::unordered_map<Key, CacheEntry> cache_map_;
+    EvictionCallback eviction_callback_;
 };
 
 }  // namespace data_structures
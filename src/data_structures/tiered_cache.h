@@ -0,0 +1,254 @@
+/**
+ * @file tiered_cache.h
+ * @brief An LRU cache that spills to a persistent on-disk tier.
+ */
+
+#ifndef CPP_UTILS_LIB_SRC_DATA_STRUCTURES_TIERED_CACHE_H_
+#define CPP_UTILS_LIB_SRC_DATA_STRUCTURES_TIERED_CACHE_H_
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "src/data_structures/lru_cache.h"
+#include "src/utils/file_utils.h"
+#include "src/utils/log_store.h"
+#include "src/utils/serializer.h"
+
+namespace cpp_utils {
+namespace data_structures {
+
+/**
+ * @brief A two-tier cache: an in-memory LRUCache in front of a LogStore.
+ *
+ * The memory tier holds the most recently used entries. Entries it evicts
+ * are written to the disk tier if they changed since they were last
+ * stored there, and a miss in memory falls through to disk and promotes
+ * the entry back into memory. The disk tier is not bounded by the memory
+ * capacity, so the cache as a whole can hold more than fits in RAM.
+ *
+ * Flush(), also called by the destructor, writes every changed entry to
+ * disk together with the memory tier's keys in recency order. Open() reads
+ * that list back and reloads those entries, so a restarted process starts
+ * with the same hot set it had before.
+ *
+ * Keys and values are stored with the given serializers; see
+ * utils::Serializer. Like LRUCache, this class is not thread-safe.
+ *
+ * @tparam Key The type of keys.
+ * @tparam Value The type of values.
+ * @tparam KeySerializer Encodes keys for the disk tier.
+ * @tparam ValueSerializer Encodes values for the disk tier.
+ */
+template <typename Key, typename Value,
+          typename KeySerializer = utils::Serializer<Key>,
+          typename ValueSerializer = utils::Serializer<Value>>
+class TieredCache {
+public:
+    /**
+     * @brief Opens a cache whose disk tier lives in a directory, warming the memory tier from it.
+     * @param memory_capacity The maximum number of entries kept in memory.
+     * @param directory The directory holding the disk tier.
+     * @param options Segment sizing and compaction settings of the disk tier.
+     * @return The cache, or nullptr if the disk tier could not be opened.
+     */
+    static std::unique_ptr<TieredCache> Open(size_t memory_capacity, const std::filesystem::path& directory,
+                                             const utils::LogStoreOptions& options = utils::LogStoreOptions()) {
+        auto store = utils::LogStore::Open(directory, options);
+        if (!store) {
+            return nullptr;
+        }
+        std::unique_ptr<TieredCache> cache(new TieredCache(memory_capacity, directory, std::move(store)));
+        cache->Warm();
+        return cache;
+    }
+
+    TieredCache(const TieredCache&) = delete;
+    TieredCache& operator=(const TieredCache&) = delete;
+
+    ~TieredCache() { Flush(); }
+
+    /**
+     * @brief Puts a key-value pair in the memory tier.
+     *
+     * The entry reaches disk when it is evicted or on the next Flush().
+     *
+     * @param key The key.
+     * @param value The value.
+     */
+    void Put(const Key& key, Value value) {
+        memory_.Put(key, Entry{std::move(value), true});
+    }
+
+    /**
+     * @brief Gets a value from memory, or from disk if it is not in memory.
+     *
+     * Either way the entry becomes the most recently used one in memory.
+     *
+     * @param key The key to look up.
+     * @return The value, or std::nullopt if neither tier has it.
+     */
+    std::optional<Value> Get(const Key& key) {
+        if (auto entry = memory_.Get(key)) {
+            return std::move(entry->value);
+        }
+        const std::optional<std::string> stored = store_->Get(EncodeKey(key));
+        if (!stored) {
+            return std::nullopt;
+        }
+        std::string_view input(*stored);
+        Value value;
+        if (!ValueSerializer::Decode(&input, &value)) {
+            return std::nullopt;
+        }
+        memory_.Put(key, Entry{value, false});
+        return value;
+    }
+
+    /**
+     * @brief Checks whether either tier has a key, without promoting it.
+     * @param key The key to check.
+     * @return True if the key exists.
+     */
+    bool Contains(const Key& key) const {
+        return memory_.Contains(key) || store_->Contains(EncodeKey(key));
+    }
+
+    /**
+     * @brief Removes a key from both tiers.
+     * @param key The key to remove.
+     * @return True if the key was removed, false if it didn't exist.
+     */
+    bool Erase(const Key& key) {
+        const bool in_memory = memory_.Erase(key);
+        const bool on_disk = store_->Erase(EncodeKey(key));
+        return in_memory || on_disk;
+    }
+
+    /**
+     * @brief Writes changed entries and the memory tier's recency order to disk.
+     * @return True on success, false if this or an earlier spill failed.
+     */
+    bool Flush() {
+        std::string hot_keys;
+        memory_.ForEach([&](const Key& key, Entry& entry) {
+            const std::string encoded = EncodeKey(key);
+            if (entry.dirty) {
+                if (Spill(encoded, entry.value)) {
+                    entry.dirty = false;
+                }
+            }
+            hot_keys.append(encoded);
+        });
+        utils::WriteOptions write_options;
+        write_options.atomic = true;
+        if (!utils::WriteFile(directory_ / kHotKeysFile, hot_keys, write_options) || !store_->Flush()) {
+            failed_ = true;
+        }
+        const bool ok = !failed_;
+        failed_ = false;
+        return ok;
+    }
+
+    /**
+     * @brief Gets the number of entries in the memory tier.
+     * @return The number of entries in memory.
+     */
+    size_t MemorySize() const {
+        return memory_.Size();
+    }
+
+    /**
+     * @brief Gets the number of entries in the disk tier.
+     *
+     * Entries that were put or changed in memory and not yet spilled are not counted.
+     *
+     * @return The number of entries on disk.
+     */
+    size_t DiskSize() const {
+        return store_->Size();
+    }
+
+    /**
+     * @brief Gets the capacity of the memory tier.
+     * @return The maximum number of entries kept in memory.
+     */
+    size_t MemoryCapacity() const {
+        return memory_.Capacity();
+    }
+
+private:
+    struct Entry {
+        Value value;
+        bool dirty;  // Changed since it was last written to disk.
+    };
+
+    /** @brief File in the cache directory listing the memory tier's keys, most recent first. */
+    static constexpr const char* kHotKeysFile = "hot_keys";
+
+    TieredCache(size_t memory_capacity, const std::filesystem::path& directory,
+                std::unique_ptr<utils::LogStore> store)
+        : directory_(directory), store_(std::move(store)), memory_(memory_capacity) {
+        memory_.SetEvictionCallback([this](const Key& key, Entry&& entry) {
+            if (entry.dirty) {
+                Spill(EncodeKey(key), entry.value);
+            }
+        });
+    }
+
+    static std::string EncodeKey(const Key& key) {
+        std::string encoded;
+        KeySerializer::Encode(key, &encoded);
+        return encoded;
+    }
+
+    bool Spill(const std::string& encoded_key, const Value& value) {
+        std::string encoded_value;
+        ValueSerializer::Encode(value, &encoded_value);
+        if (!store_->Put(encoded_key, encoded_value)) {
+            failed_ = true;
+            return false;
+        }
+        return true;
+    }
+
+    // Reloads the hot set saved by the last Flush(), least recent first so the
+    // memory tier ends up in the same order.
+    void Warm() {
+        const std::optional<std::string> hot_keys = utils::ReadFile(directory_ / kHotKeysFile);
+        if (!hot_keys) {
+            return;
+        }
+        std::vector<Key> keys;
+        std::string_view input(*hot_keys);
+        Key key;
+        while (!input.empty() && keys.size() < memory_.Capacity() && KeySerializer::Decode(&input, &key)) {
+            keys.push_back(std::move(key));
+        }
+        for (auto it = keys.rbegin(); it != keys.rend(); ++it) {
+            const std::optional<std::string> stored = store_->Get(EncodeKey(*it));
+            if (!stored) {
+                continue;
+            }
+            std::string_view value_input(*stored);
+            Value value;
+            if (ValueSerializer::Decode(&value_input, &value)) {
+                memory_.Put(*it, Entry{std::move(value), false});
+            }
+        }
+    }
+
+    const std::filesystem::path directory_;
+    std::unique_ptr<utils::LogStore> store_;
+    LRUCache<Key, Entry> memory_;
+    bool failed_ = false;  // A spill failed since the last Flush().
+};
+
+}  // namespace data_structures
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_SRC_DATA_STRUCTURES_TIERED_CACHE_H_
@@ -0,0 +1,160 @@
+#include "src/utils/append_writer.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+// Writes every byte described by iov, resuming after short writes.
+bool WriteFully(int fd, std::vector<iovec>* iov) {
+    size_t first = 0;
+    while (first < iov->size()) {
+        const int count = static_cast<int>(std::min<size_t>(iov->size() - first, IOV_MAX));
+        ssize_t written = ::writev(fd, iov->data() + first, count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        // Skip the fully written entries and trim the partly written one.
+        while (first < iov->size() && static_cast<size_t>(written) >= (*iov)[first].iov_len) {
+            written -= static_cast<ssize_t>((*iov)[first].iov_len);
+            ++first;
+        }
+        if (first < iov->size()) {
+            (*iov)[first].iov_base = static_cast<char*>((*iov)[first].iov_base) + written;
+            (*iov)[first].iov_len -= static_cast<size_t>(written);
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+std::unique_ptr<AppendWriter> AppendWriter::Open(const std::filesystem::path& filename,
+                                                 const AppendOptions& options) {
+    // Like AppendToFile, new files get 0666 less the umask.
+    const int fd = ::open(filename.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0666);
+    if (fd < 0) {
+        return nullptr;
+    }
+    return std::unique_ptr<AppendWriter>(new AppendWriter(fd, options));
+}
+
+AppendWriter::AppendWriter(int fd, const AppendOptions& options)
+    : fd_(fd), options_(options), buffer_(new char[std::max<size_t>(options.buffer_size, 1)]) {}
+
+AppendWriter::~AppendWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        FlushLocked();
+    }
+    ::close(fd_);
+}
+
+bool AppendWriter::Append(std::string_view record) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return AppendLocked(&record, 1);
+}
+
+bool AppendWriter::Append(std::initializer_list<std::string_view> parts) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return AppendLocked(parts.begin(), parts.size());
+}
+
+bool AppendWriter::AppendLocked(const std::string_view* parts, size_t count) {
+    if (failed_) {
+        return false;
+    }
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += parts[i].size();
+    }
+    bytes_appended_ += total;
+
+    const size_t capacity = std::max<size_t>(options_.buffer_size, 1);
+    if (total > capacity - size_) {
+        // Too big to buffer: send the buffer and the record in one writev.
+        return WriteOut(parts, count);
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (size_ == 0) {
+        oldest_ = now;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (!parts[i].empty()) {
+            std::memcpy(buffer_.get() + size_, parts[i].data(), parts[i].size());
+            size_ += parts[i].size();
+        }
+    }
+    const bool expired = options_.flush_interval.count() > 0 && now - oldest_ >= options_.flush_interval;
+    if (size_ == capacity || expired) {
+        return FlushLocked();
+    }
+    return true;
+}
+
+bool AppendWriter::Flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return FlushLocked();
+}
+
+bool AppendWriter::FlushLocked() {
+    if (failed_) {
+        return false;
+    }
+    if (size_ == 0) {
+        return true;
+    }
+    return WriteOut(nullptr, 0);
+}
+
+bool AppendWriter::WriteOut(const std::string_view* parts, size_t count) {
+    std::vector<iovec> iov;
+    iov.reserve(count + 1);
+    if (size_ > 0) {
+        iov.push_back({buffer_.get(), size_});
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (!parts[i].empty()) {
+            iov.push_back({const_cast<char*>(parts[i].data()), parts[i].size()});
+        }
+    }
+    size_ = 0;
+    if (!WriteFully(fd_, &iov) || (options_.sync_on_flush && ::fdatasync(fd_) != 0)) {
+        failed_ = true;
+        return false;
+    }
+    return true;
+}
+
+bool AppendWriter::Sync() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!FlushLocked()) {
+        return false;
+    }
+    if (!options_.sync_on_flush && ::fdatasync(fd_) != 0) {
+        failed_ = true;
+        return false;
+    }
+    return true;
+}
+
+uint64_t AppendWriter::BytesAppended() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_appended_;
+}
+
+}  // namespace utils
+}  // namespace cpp_utils
@@ -0,0 +1,114 @@
+/**
+ * @file append_writer.h
+ * @brief Buffered appends to a file that stays open between records.
+ */
+
+#ifndef CPP_UTILS_LIB_SRC_UTILS_APPEND_WRITER_H_
+#define CPP_UTILS_LIB_SRC_UTILS_APPEND_WRITER_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string_view>
+
+namespace cpp_utils {
+namespace utils {
+
+/**
+ * @brief When an AppendWriter hands its buffer to the kernel.
+ */
+struct AppendOptions {
+    size_t buffer_size = 1 << 20;                 // Flush once this many bytes are buffered.
+    std::chrono::milliseconds flush_interval{0};  // Flush on an append once buffered data is this old; 0 disables.
+    bool sync_on_flush = false;                   // fdatasync after every flush, not just on Sync().
+};
+
+/**
+ * @brief Appends records to a file through a user-space buffer.
+ *
+ * The file is opened once with O_APPEND, and records are copied into a
+ * buffer that is written out with a single syscall when it fills up, when
+ * the flush interval has passed, or on Flush()/Sync(). A record that does
+ * not fit is written together with the buffered bytes in one writev call
+ * instead of being copied. The destructor flushes whatever is left.
+ *
+ * All methods are thread-safe. Once a write fails the writer stays failed
+ * and every later call returns false.
+ */
+class AppendWriter {
+public:
+    /**
+     * @brief Opens a file for appending, creating it if necessary.
+     * @param filename The path to the file.
+     * @param options Buffering and durability settings.
+     * @return The writer, or nullptr if the file could not be opened.
+     */
+    static std::unique_ptr<AppendWriter> Open(const std::filesystem::path& filename,
+                                              const AppendOptions& options = AppendOptions());
+
+    AppendWriter(const AppendWriter&) = delete;
+    AppendWriter& operator=(const AppendWriter&) = delete;
+
+    ~AppendWriter();
+
+    /**
+     * @brief Appends one record.
+     * @param record The bytes to append.
+     * @return True if the record was buffered or written, false otherwise.
+     */
+    bool Append(std::string_view record);
+
+    /**
+     * @brief Appends a record made of several parts, e.g. a header and a payload.
+     *
+     * The parts are written contiguously without first being joined.
+     *
+     * @param parts The pieces of the record, in order.
+     * @return True if the record was buffered or written, false otherwise.
+     */
+    bool Append(std::initializer_list<std::string_view> parts);
+
+    /**
+     * @brief Writes the buffered bytes to the file.
+     * @return True if the operation was successful, false otherwise.
+     */
+    bool Flush();
+
+    /**
+     * @brief Flushes, then waits until the data is on stable storage (fdatasync).
+     * @return True if the operation was successful, false otherwise.
+     */
+    bool Sync();
+
+    /**
+     * @brief Gets the number of bytes appended through this writer, buffered or not.
+     * @return The number of bytes.
+     */
+    uint64_t BytesAppended() const;
+
+private:
+    AppendWriter(int fd, const AppendOptions& options);
+
+    // Writes the buffer followed by the given parts; callers hold mutex_.
+    bool WriteOut(const std::string_view* parts, size_t count);
+    bool FlushLocked();
+    bool AppendLocked(const std::string_view* parts, size_t count);
+
+    const int fd_;
+    const AppendOptions options_;
+    std::unique_ptr<char[]> buffer_;
+    size_t size_ = 0;
+    std::chrono::steady_clock::time_point oldest_;  // When the buffer went from empty to non-empty.
+    uint64_t bytes_appended_ = 0;
+    bool failed_ = false;
+    mutable std::mutex mutex_;
+};
+
+}  // namespace utils
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_SRC_UTILS_APPEND_WRITER_H_
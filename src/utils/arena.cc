@@ -0,0 +1,54 @@
+#include "src/utils/arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace cpp_utils {
+namespace utils {
+
+Arena::Arena(size_t block_size) : block_size_(block_size > 0 ? block_size : 1) {}
+
+void Arena::Reset() {
+    current_ = 0;
+    offset_ = 0;
+    bytes_used_ = 0;
+}
+
+void* Arena::do_allocate(size_t bytes, size_t alignment) {
+    if (void* p = TryAllocate(bytes, alignment)) {
+        return p;
+    }
+    // Move on to the next retained block that fits, or add a new one.
+    while (current_ + 1 < blocks_.size()) {
+        ++current_;
+        offset_ = 0;
+        if (void* p = TryAllocate(bytes, alignment)) {
+            return p;
+        }
+    }
+    const size_t size = std::max(block_size_, bytes + alignment);
+    blocks_.push_back(Block{std::unique_ptr<char[]>(new char[size]), size});
+    bytes_reserved_ += size;
+    current_ = blocks_.size() - 1;
+    offset_ = 0;
+    return TryAllocate(bytes, alignment);
+}
+
+void* Arena::TryAllocate(size_t bytes, size_t alignment) {
+    if (current_ >= blocks_.size()) {
+        return nullptr;
+    }
+    const Block& block = blocks_[current_];
+    const auto base = reinterpret_cast<uintptr_t>(block.data.get());
+    const uintptr_t aligned = (base + offset_ + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+    const size_t end = static_cast<size_t>(aligned - base) + bytes;
+    if (end > block.size) {
+        return nullptr;
+    }
+    bytes_used_ += end - offset_;
+    offset_ = end;
+    return reinterpret_cast<void*>(aligned);
+}
+
+}  // namespace utils
+}  // namespace cpp_utils
@@ -0,0 +1,84 @@
+/**
+ * @file arena.h
+ * @brief A resettable monotonic arena usable as a std::pmr memory resource.
+ */
+
+#ifndef CPP_UTILS_LIB_SRC_UTILS_ARENA_H_
+#define CPP_UTILS_LIB_SRC_UTILS_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace cpp_utils {
+namespace utils {
+
+/**
+ * @brief A monotonic allocator whose memory is released all at once.
+ *
+ * Allocation bumps a pointer inside the current block; deallocation is a
+ * no-op. Reset() rewinds to the first block and keeps every block for
+ * reuse, so a per-line parsing loop that resets the arena after each line
+ * stops calling malloc once the arena has grown to fit the largest line.
+ * Pass the arena to std::pmr containers, or to the string_utils overloads
+ * taking a std::pmr::memory_resource*. Not thread-safe.
+ */
+class Arena : public std::pmr::memory_resource {
+public:
+    /**
+     * @brief Constructs an empty arena.
+     * @param block_size The size of each block; larger requests get a block of their own.
+     */
+    explicit Arena(size_t block_size = 4096);
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief Invalidates everything allocated so far and rewinds to the first block.
+     *
+     * Objects allocated from the arena are not destroyed; only use this for
+     * data whose destructors do nothing beyond freeing arena memory.
+     */
+    void Reset();
+
+    /**
+     * @brief Gets the number of bytes handed out since the last Reset().
+     * @return The bytes in use, including alignment padding.
+     */
+    size_t BytesUsed() const { return bytes_used_; }
+
+    /**
+     * @brief Gets the total size of all blocks owned by the arena.
+     * @return The bytes reserved.
+     */
+    size_t BytesReserved() const { return bytes_reserved_; }
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    // Carves bytes out of the current block, or returns nullptr if they don't fit.
+    void* TryAllocate(size_t bytes, size_t alignment);
+
+    const size_t block_size_;
+    std::vector<Block> blocks_;
+    size_t current_ = 0;   // Index of the block being carved.
+    size_t offset_ = 0;    // Bytes used in the current block.
+    size_t bytes_used_ = 0;
+    size_t bytes_reserved_ = 0;
+};
+
+}  // namespace utils
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_SRC_UTILS_ARENA_H_
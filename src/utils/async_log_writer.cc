@@ -0,0 +1,74 @@
+#include "src/utils/async_log_writer.h"
+
+#include <utility>
+
+namespace cpp_utils {
+namespace utils {
+
+std::unique_ptr<AsyncLogWriter> AsyncLogWriter::Open(const std::filesystem::path& filename,
+                                                     const AsyncLogOptions& options) {
+    auto writer = AppendWriter::Open(filename);
+    if (!writer) {
+        return nullptr;
+    }
+    return std::unique_ptr<AsyncLogWriter>(new AsyncLogWriter(std::move(writer), options));
+}
+
+AsyncLogWriter::AsyncLogWriter(std::unique_ptr<AppendWriter> writer, const AsyncLogOptions& options)
+    : options_(options), writer_(std::move(writer)), thread_(&AsyncLogWriter::Run, this) {}
+
+AsyncLogWriter::~AsyncLogWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    condition_.notify_one();
+    thread_.join();
+}
+
+std::future<bool> AsyncLogWriter::Append(std::string record) {
+    Pending pending{std::move(record), std::promise<bool>()};
+    std::future<bool> done = pending.done.get_future();
+    bool was_empty;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        was_empty = pending_.empty();
+        pending_.push_back(std::move(pending));
+    }
+    // The I/O thread only sleeps on an empty batch.
+    if (was_empty) {
+        condition_.notify_one();
+    }
+    return done;
+}
+
+void AsyncLogWriter::Run() {
+    std::vector<Pending> batch;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this]() { return stopping_ || !pending_.empty(); });
+            if (pending_.empty()) {
+                return;
+            }
+            if (options_.commit_delay.count() > 0 && !stopping_) {
+                condition_.wait_for(lock, options_.commit_delay, [this]() { return stopping_; });
+            }
+            batch.swap(pending_);
+        }
+
+        bool ok = true;
+        for (const Pending& pending : batch) {
+            ok = writer_->Append(pending.record) && ok;
+        }
+        ok = (options_.sync ? writer_->Sync() : writer_->Flush()) && ok;
+        batches_.fetch_add(1, std::memory_order_relaxed);
+        for (Pending& pending : batch) {
+            pending.done.set_value(ok);
+        }
+        batch.clear();
+    }
+}
+
+}  // namespace utils
+}  // namespace cpp_utils
@@ -0,0 +1,101 @@
+/**
+ * @file async_log_writer.h
+ * @brief Durable appends committed in groups by a background thread.
+ */
+
+#ifndef CPP_UTILS_LIB_SRC_UTILS_ASYNC_LOG_WRITER_H_
+#define CPP_UTILS_LIB_SRC_UTILS_ASYNC_LOG_WRITER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "src/utils/append_writer.h"
+
+namespace cpp_utils {
+namespace utils {
+
+/**
+ * @brief How an AsyncLogWriter commits each batch.
+ */
+struct AsyncLogOptions {
+    bool sync = true;                          // fdatasync each batch before reporting it complete.
+    std::chrono::microseconds commit_delay{0};  // Wait this long for more records before committing a batch.
+};
+
+/**
+ * @brief Appends records to a file from a dedicated I/O thread.
+ *
+ * Producers only move their record into a pending batch and get a future
+ * back; they never touch the file. The I/O thread takes the whole batch at
+ * once, writes it with a single buffered write and, with sync enabled, one
+ * fdatasync, then completes every future in the batch. Records arriving
+ * while a batch is being synced form the next batch, so concurrent
+ * producers share the cost of each fsync.
+ *
+ * Records are written in the order Append() was called. The destructor
+ * commits everything still pending before returning.
+ */
+class AsyncLogWriter {
+public:
+    /**
+     * @brief Opens a file for appending and starts the I/O thread.
+     * @param filename The path to the file; created if necessary.
+     * @param options Commit settings.
+     * @return The writer, or nullptr if the file could not be opened.
+     */
+    static std::unique_ptr<AsyncLogWriter> Open(const std::filesystem::path& filename,
+                                                const AsyncLogOptions& options = AsyncLogOptions());
+
+    AsyncLogWriter(const AsyncLogWriter&) = delete;
+    AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+    ~AsyncLogWriter();
+
+    /**
+     * @brief Queues a record for the next batch.
+     * @param record The bytes to append.
+     * @return A future that becomes true once the record's batch is committed,
+     *         or false if writing it failed.
+     */
+    std::future<bool> Append(std::string record);
+
+    /**
+     * @brief Gets the number of batches committed so far.
+     * @return The number of batches.
+     */
+    uint64_t BatchCount() const { return batches_.load(std::memory_order_relaxed); }
+
+private:
+    struct Pending {
+        std::string record;
+        std::promise<bool> done;
+    };
+
+    AsyncLogWriter(std::unique_ptr<AppendWriter> writer, const AsyncLogOptions& options);
+
+    // Body of the I/O thread: takes and commits batches until stopped and drained.
+    void Run();
+
+    const AsyncLogOptions options_;
+    std::unique_ptr<AppendWriter> writer_;
+    std::vector<Pending> pending_;
+    bool stopping_ = false;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::atomic<uint64_t> batches_{0};
+    std::thread thread_;
+};
+
+}  // namespace utils
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_SRC_UTILS_ASYNC_LOG_WRITER_H_
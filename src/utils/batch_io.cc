@@ -0,0 +1,525 @@
+#include "src/utils/batch_io.h"
+
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <thread>
+
+#include "src/utils/file_utils.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#define CPP_UTILS_IO_URING 1
+#include <linux/io_uring.h>
+#endif
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+// Runs fn(i) for every i in [0, count) on up to `threads` threads.
+template <typename Fn>
+void ParallelFor(size_t count, size_t threads, const Fn& fn) {
+    std::atomic<size_t> next{0};
+    auto work = [&]() {
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            fn(i);
+        }
+    };
+    const size_t workers = std::min(threads, count);
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < workers; ++i) {
+        pool.emplace_back(work);
+    }
+    work();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+size_t PoolSize(size_t threads) {
+    if (threads > 0) {
+        return threads;
+    }
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+}  // namespace
+
+#ifdef CPP_UTILS_IO_URING
+
+/**
+ * @brief A minimal io_uring instance driven through raw syscalls.
+ *
+ * Each file in a batch moves through open, (statx,) read or write, and
+ * close, with exactly one operation outstanding at a time; up to
+ * queue_depth files are in flight together.
+ */
+class BatchIo::Ring {
+public:
+    // One file moving through the pipeline.
+    struct FileOp {
+        enum Stage { kOpen, kStat, kTransfer, kClose };
+
+        Stage stage = kOpen;
+        const char* path = nullptr;
+        int fd = -1;
+        std::string* read_buffer = nullptr;  // Set for reads.
+        std::string_view write_data;         // Used for writes.
+        size_t done = 0;                     // Bytes transferred so far.
+        bool ok = false;
+        bool finished = false;               // Has passed through every stage; ok is final.
+        struct statx stx;
+    };
+
+    static std::unique_ptr<Ring> Create(unsigned entries, std::function<bool()> before_submit) {
+        std::unique_ptr<Ring> ring(new Ring());
+        ring->before_submit_ = std::move(before_submit);
+        if (!ring->Init(entries) || !ring->SupportsFileOps()) {
+            return nullptr;
+        }
+        return ring;
+    }
+
+    ~Ring() {
+        if (sqes_ != nullptr) {
+            ::munmap(sqes_, sqes_size_);
+        }
+        if (cq_ptr_ != nullptr && cq_ptr_ != sq_ptr_) {
+            ::munmap(cq_ptr_, cq_size_);
+        }
+        if (sq_ptr_ != nullptr) {
+            ::munmap(sq_ptr_, sq_size_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    unsigned Entries() const { return entries_; }
+
+    // Drives every op to completion. Returns false if the ring itself
+    // failed; by then the kernel is done with every op and every fd it
+    // opened is closed, and the ops not marked finished must be redone.
+    bool Run(std::vector<FileOp>* ops, bool write) {
+        write_ = write;
+        size_t next = 0;
+        size_t in_flight = 0;
+        while (next < ops->size() || in_flight > 0) {
+            for (; next < ops->size() && in_flight < entries_; ++next, ++in_flight) {
+                QueueOpen(&(*ops)[next], next);
+            }
+            if (!SubmitAndWait()) {
+                Abandon(ops, in_flight);
+                return false;
+            }
+            io_uring_cqe cqe;
+            while (PopCompletion(&cqe)) {
+                FileOp* op = &(*ops)[cqe.user_data];
+                if (!Advance(op, cqe.user_data, cqe.res)) {
+                    op->finished = true;
+                    --in_flight;
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    Ring() = default;
+
+    bool Init(unsigned entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (fd_ < 0) {
+            return false;
+        }
+        entries_ = params.sq_entries;
+
+        sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+        }
+        sq_ptr_ = Map(sq_size_, IORING_OFF_SQ_RING);
+        if (sq_ptr_ == nullptr) {
+            return false;
+        }
+        cq_ptr_ = single_mmap ? sq_ptr_ : Map(cq_size_, IORING_OFF_CQ_RING);
+        if (cq_ptr_ == nullptr) {
+            return false;
+        }
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(Map(sqes_size_, IORING_OFF_SQES));
+        if (sqes_ == nullptr) {
+            return false;
+        }
+
+        char* sq = static_cast<char*>(sq_ptr_);
+        sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        char* cq = static_cast<char*>(cq_ptr_);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        local_tail_ = *sq_tail_;
+        return true;
+    }
+
+    void* Map(size_t size, off_t offset) {
+        void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, offset);
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    // Kernels before 5.6 lack the open/statx/close opcodes.
+    bool SupportsFileOps() {
+        constexpr unsigned kOps = 256;
+        std::vector<char> storage(sizeof(io_uring_probe) + kOps * sizeof(io_uring_probe_op), 0);
+        auto* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+        if (::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_PROBE, probe, kOps) < 0) {
+            return false;
+        }
+        for (unsigned op : {IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ, IORING_OP_WRITE, IORING_OP_CLOSE}) {
+            if (op >= probe->ops_len || (probe->ops[op].flags & IO_URING_OP_SUPPORTED) == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Every in-flight file has at most one operation queued and there are
+    // never more files in flight than entries, so a slot is always free.
+    io_uring_sqe* NextSqe(uint8_t opcode, int fd, uint64_t user_data) {
+        const unsigned index = local_tail_ & sq_mask_;
+        io_uring_sqe* sqe = &sqes_[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = opcode;
+        sqe->fd = fd;
+        sqe->user_data = user_data;
+        sq_array_[index] = index;
+        ++local_tail_;
+        ++unsubmitted_;
+        return sqe;
+    }
+
+    void QueueOpen(FileOp* op, uint64_t id) {
+        op->stage = FileOp::kOpen;
+        io_uring_sqe* sqe = NextSqe(IORING_OP_OPENAT, AT_FDCWD, id);
+        sqe->addr = reinterpret_cast<uint64_t>(op->path);
+        sqe->open_flags = write_ ? (O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC) : (O_RDONLY | O_CLOEXEC);
+        sqe->len = 0666;  // Less the umask, as with WriteFile.
+    }
+
+    void QueueStat(FileOp* op, uint64_t id) {
+        op->stage = FileOp::kStat;
+        io_uring_sqe* sqe = NextSqe(IORING_OP_STATX, op->fd, id);
+        sqe->addr = reinterpret_cast<uint64_t>("");
+        sqe->len = STATX_SIZE;
+        sqe->statx_flags = AT_EMPTY_PATH;
+        sqe->off = reinterpret_cast<uint64_t>(&op->stx);
+    }
+
+    void QueueTransfer(FileOp* op, uint64_t id) {
+        op->stage = FileOp::kTransfer;
+        io_uring_sqe* sqe;
+        if (write_) {
+            sqe = NextSqe(IORING_OP_WRITE, op->fd, id);
+            sqe->addr = reinterpret_cast<uint64_t>(op->write_data.data() + op->done);
+            sqe->len = static_cast<uint32_t>(std::min<size_t>(op->write_data.size() - op->done, 1u << 30));
+        } else {
+            sqe = NextSqe(IORING_OP_READ, op->fd, id);
+            sqe->addr = reinterpret_cast<uint64_t>(op->read_buffer->data() + op->done);
+            sqe->len = static_cast<uint32_t>(std::min<size_t>(op->read_buffer->size() - op->done, 1u << 30));
+        }
+        sqe->off = op->done;
+    }
+
+    void QueueClose(FileOp* op, uint64_t id) {
+        op->stage = FileOp::kClose;
+        NextSqe(IORING_OP_CLOSE, op->fd, id);
+    }
+
+    size_t TransferSize(const FileOp& op) const {
+        return write_ ? op.write_data.size() : op.read_buffer->size();
+    }
+
+    // Moves a file to its next stage. Returns false once the file is finished.
+    bool Advance(FileOp* op, uint64_t id, int32_t res) {
+        switch (op->stage) {
+            case FileOp::kOpen:
+                if (res < 0) {
+                    return false;
+                }
+                op->fd = res;
+                if (!write_) {
+                    QueueStat(op, id);
+                } else if (op->write_data.empty()) {
+                    op->ok = true;
+                    QueueClose(op, id);
+                } else {
+                    QueueTransfer(op, id);
+                }
+                return true;
+            case FileOp::kStat:
+                if (res < 0) {
+                    QueueClose(op, id);
+                    return true;
+                }
+                op->read_buffer->resize(static_cast<size_t>(op->stx.stx_size));
+                if (op->read_buffer->empty()) {
+                    op->ok = true;
+                    QueueClose(op, id);
+                } else {
+                    QueueTransfer(op, id);
+                }
+                return true;
+            case FileOp::kTransfer:
+                if (res == -EINTR || res == -EAGAIN) {
+                    QueueTransfer(op, id);
+                    return true;
+                }
+                if (res <= 0) {
+                    // A read hitting end of file early means the file shrank.
+                    if (res == 0 && !write_) {
+                        op->read_buffer->resize(op->done);
+                        op->ok = true;
+                    }
+                    QueueClose(op, id);
+                    return true;
+                }
+                op->done += static_cast<size_t>(res);
+                if (op->done < TransferSize(*op)) {
+                    QueueTransfer(op, id);
+                } else {
+                    op->ok = true;
+                    QueueClose(op, id);
+                }
+                return true;
+            case FileOp::kClose:
+                op->fd = -1;
+                if (res < 0 && write_) {
+                    op->ok = false;
+                }
+                return false;
+        }
+        return false;
+    }
+
+    // Waits out every op the kernel has accepted, so none of them can still
+    // write into an op's buffers once this returns, then closes the fds they
+    // left open. SQEs the kernel never consumed stay unsubmitted: the ring is
+    // not entered with anything to submit again.
+    void Abandon(std::vector<FileOp>* ops, size_t in_flight) {
+        // Each in-flight file has one SQE outstanding, and every SQE the
+        // kernel consumed posts exactly one CQE.
+        const unsigned unconsumed = local_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+        size_t pending = in_flight - unconsumed;
+        io_uring_cqe cqe;
+        while (pending > 0) {
+            if (PopCompletion(&cqe)) {
+                Settle(&(*ops)[cqe.user_data], cqe.res);
+                --pending;
+                continue;
+            }
+            // Completions land in the ring even if waiting for them fails.
+            if (::syscall(__NR_io_uring_enter, fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0 &&
+                errno != EINTR) {
+                ::sched_yield();
+            }
+        }
+        for (FileOp& op : *ops) {
+            if (op.fd >= 0) {
+                ::close(op.fd);
+                op.fd = -1;
+            }
+        }
+    }
+
+    // Records a completion seen while abandoning the batch, without queueing
+    // the file's next stage.
+    void Settle(FileOp* op, int32_t res) {
+        switch (op->stage) {
+            case FileOp::kOpen:
+                if (res >= 0) {
+                    op->fd = res;
+                }
+                break;
+            case FileOp::kClose:
+                op->finished = !Advance(op, 0, res);
+                break;
+            default:
+                break;
+        }
+    }
+
+    bool SubmitAndWait() {
+        __atomic_store_n(sq_tail_, local_tail_, __ATOMIC_RELEASE);
+        if (before_submit_ && !before_submit_()) {
+            return false;
+        }
+        while (true) {
+            const long submitted = ::syscall(__NR_io_uring_enter, fd_, unsubmitted_, 1,
+                                             IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (submitted >= 0) {
+                unsubmitted_ -= static_cast<unsigned>(submitted);
+                return true;
+            }
+            if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                return false;
+            }
+        }
+    }
+
+    bool PopCompletion(io_uring_cqe* cqe) {
+        const unsigned head = *cq_head_;
+        if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+            return false;
+        }
+        *cqe = cqes_[head & cq_mask_];
+        __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+
+    int fd_ = -1;
+    unsigned entries_ = 0;
+    bool write_ = false;
+    void* sq_ptr_ = nullptr;
+    void* cq_ptr_ = nullptr;
+    size_t sq_size_ = 0;
+    size_t cq_size_ = 0;
+    size_t sqes_size_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    io_uring_cqe* cqes_ = nullptr;
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    unsigned local_tail_ = 0;   // SQEs prepared, including those not yet published.
+    unsigned unsubmitted_ = 0;  // SQEs published but not yet consumed by io_uring_enter.
+    std::function<bool()> before_submit_;
+};
+
+#else  // CPP_UTILS_IO_URING
+
+class BatchIo::Ring {};
+
+#endif  // CPP_UTILS_IO_URING
+
+BatchIo::BatchIo(const BatchIoOptions& options) : options_(options) {
+#ifdef CPP_UTILS_IO_URING
+    if (options.use_io_uring) {
+        ring_ = Ring::Create(std::max(options.queue_depth, 1u), options.before_submit);
+    }
+#endif
+}
+
+BatchIo::~BatchIo() = default;
+
+const char* BatchIo::EngineName() const {
+    return ring_ ? "io_uring" : "threads";
+}
+
+std::vector<std::optional<std::string>> BatchIo::ReadFiles(const std::vector<std::filesystem::path>& filenames) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::optional<std::string>> results(filenames.size());
+#ifdef CPP_UTILS_IO_URING
+    if (ring_) {
+        std::vector<std::string> buffers(filenames.size());
+        std::vector<Ring::FileOp> ops(filenames.size());
+        for (size_t i = 0; i < ops.size(); ++i) {
+            ops[i].path = filenames[i].c_str();
+            ops[i].read_buffer = &buffers[i];
+        }
+        const bool ran = ring_->Run(&ops, false);
+        std::vector<size_t> unfinished;
+        for (size_t i = 0; i < ops.size(); ++i) {
+            if (!ops[i].finished) {
+                unfinished.push_back(i);
+            } else if (ops[i].ok) {
+                results[i] = std::move(buffers[i]);
+            }
+        }
+        if (ran) {
+            return results;
+        }
+        // The ring broke down mid-batch; finish the rest on threads.
+        ring_.reset();
+        ParallelFor(unfinished.size(), PoolSize(options_.threads), [&](size_t i) {
+            results[unfinished[i]] = ReadFile(filenames[unfinished[i]]);
+        });
+        return results;
+    }
+#endif
+    ParallelFor(filenames.size(), PoolSize(options_.threads), [&](size_t i) {
+        results[i] = ReadFile(filenames[i]);
+    });
+    return results;
+}
+
+std::vector<bool> BatchIo::WriteFiles(const std::vector<std::pair<std::filesystem::path, std::string_view>>& files) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<bool> results(files.size(), false);
+#ifdef CPP_UTILS_IO_URING
+    if (ring_) {
+        std::vector<Ring::FileOp> ops(files.size());
+        for (size_t i = 0; i < ops.size(); ++i) {
+            ops[i].path = files[i].first.c_str();
+            ops[i].write_data = files[i].second;
+        }
+        const bool ran = ring_->Run(&ops, true);
+        std::vector<size_t> unfinished;
+        for (size_t i = 0; i < ops.size(); ++i) {
+            if (!ops[i].finished) {
+                unfinished.push_back(i);
+            }
+            results[i] = ops[i].ok && ops[i].finished;
+        }
+        if (ran) {
+            return results;
+        }
+        ring_.reset();
+        std::vector<char> written(unfinished.size(), 0);
+        ParallelFor(unfinished.size(), PoolSize(options_.threads), [&](size_t i) {
+            written[i] = WriteFile(files[unfinished[i]].first, files[unfinished[i]].second);
+        });
+        for (size_t i = 0; i < unfinished.size(); ++i) {
+            results[unfinished[i]] = written[i];
+        }
+        return results;
+    }
+#endif
+    // std::vector<bool> packs bits, so workers write to a byte array instead.
+    std::vector<char> written(files.size(), 0);
+    ParallelFor(files.size(), PoolSize(options_.threads), [&](size_t i) {
+        written[i] = WriteFile(files[i].first, files[i].second);
+    });
+    std::copy(written.begin(), written.end(), results.begin());
+    return results;
+}
+
+std::vector<std::optional<std::string>> ReadFiles(const std::vector<std::filesystem::path>& filenames) {
+    return BatchIo().ReadFiles(filenames);
+}
+
+std::vector<bool> WriteFiles(const std::vector<std::pair<std::filesystem::path, std::string_view>>& files) {
+    return BatchIo().WriteFiles(files);
+}
+
+}  // namespace utils
+}  // namespace cpp_utils
@@ -0,0 +1,108 @@
+/**
+ * @file batch_io.h
+ * @brief Reads and writes many whole files with a deep queue of outstanding I/O.
+ */
+
+#ifndef CPP_UTILS_LIB_SRC_UTILS_BATCH_IO_H_
+#define CPP_UTILS_LIB_SRC_UTILS_BATCH_IO_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace cpp_utils {
+namespace utils {
+
+/**
+ * @brief Settings for a BatchIo engine.
+ */
+struct BatchIoOptions {
+    unsigned queue_depth = 64;  // Files kept in flight at once.
+    size_t threads = 0;         // Thread-pool fallback size; 0 means one per core.
+    bool use_io_uring = true;   // Set to false to force the thread-pool fallback.
+    // Called before each io_uring submission; returning false makes it fail
+    // as if the kernel had refused it. Meant for tests.
+    std::function<bool()> before_submit;
+};
+
+/**
+ * @brief Batched whole-file reads and writes.
+ *
+ * On Linux kernels with io_uring the open, stat, read/write and close of
+ * every file are submitted as asynchronous operations, and up to
+ * queue_depth files are in flight at once, so a batch costs a handful of
+ * syscalls instead of several per file. Where io_uring is missing or
+ * disabled, the batch is spread over a pool of threads that call ReadFile
+ * and WriteFile instead. If io_uring fails partway through a batch, the
+ * engine waits for the operations already submitted, then finishes the
+ * remaining files on threads and uses threads from then on.
+ *
+ * Results are returned in input order. Concurrent batches on one engine
+ * are serialized.
+ */
+class BatchIo {
+public:
+    /**
+     * @brief Sets up the engine, falling back to threads if io_uring is unavailable.
+     * @param options Queue depth and engine selection.
+     */
+    explicit BatchIo(const BatchIoOptions& options = BatchIoOptions());
+
+    BatchIo(const BatchIo&) = delete;
+    BatchIo& operator=(const BatchIo&) = delete;
+
+    ~BatchIo();
+
+    /**
+     * @brief Reads several files in full.
+     * @param filenames The paths to read.
+     * @return One entry per path: its contents, or std::nullopt if it could not be read.
+     */
+    std::vector<std::optional<std::string>> ReadFiles(const std::vector<std::filesystem::path>& filenames);
+
+    /**
+     * @brief Writes several files, replacing any existing contents.
+     * @param files Pairs of (path, data).
+     * @return One entry per file: true if it was written completely.
+     */
+    std::vector<bool> WriteFiles(const std::vector<std::pair<std::filesystem::path, std::string_view>>& files);
+
+    /**
+     * @brief Names the engine in use.
+     * @return "io_uring" or "threads".
+     */
+    const char* EngineName() const;
+
+private:
+    class Ring;
+
+    const BatchIoOptions options_;
+    std::unique_ptr<Ring> ring_;  // Null when using the thread pool.
+    std::mutex mutex_;
+};
+
+/**
+ * @brief Reads several files with a default BatchIo.
+ * @param filenames The paths to read.
+ * @return One entry per path: its contents, or std::nullopt if it could not be read.
+ */
+std::vector<std::optional<std::string>> ReadFiles(const std::vector<std::filesystem::path>& filenames);
+
+/**
+ * @brief Writes several files with a default BatchIo.
+ * @param files Pairs of (path, data).
+ * @return One entry per file: true if it was written completely.
+ */
+std::vector<bool> WriteFiles(const std::vector<std::pair<std::filesystem::path, std::string_view>>& files);
+
+}  // namespace utils
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_SRC_UTILS_BATCH_IO_H_
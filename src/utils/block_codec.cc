@@ -0,0 +1,164 @@
+#include "src/utils/block_codec.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+constexpr size_t kMinMatch = 4;
+constexpr size_t kMaxOffset = 65535;
+constexpr int kHashBits = 14;
+
+uint32_t Load32(const char* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t Hash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - kHashBits);
+}
+
+// Writes the part of a length that does not fit in its 4-bit token field.
+void PutExtraLength(std::string* out, size_t length) {
+    while (length >= 255) {
+        out->push_back(static_cast<char>(255));
+        length -= 255;
+    }
+    out->push_back(static_cast<char>(length));
+}
+
+void PutSequence(std::string* out, std::string_view literals, size_t offset, size_t match_length) {
+    const size_t match_code = match_length >= kMinMatch ? match_length - kMinMatch : 0;
+    const auto token = static_cast<char>((std::min<size_t>(literals.size(), 15) << 4) |
+                                         std::min<size_t>(match_code, 15));
+    out->push_back(token);
+    if (literals.size() >= 15) {
+        PutExtraLength(out, literals.size() - 15);
+    }
+    out->append(literals);
+    if (match_length == 0) {
+        return;
+    }
+    out->push_back(static_cast<char>(offset & 0xFF));
+    out->push_back(static_cast<char>(offset >> 8));
+    if (match_code >= 15) {
+        PutExtraLength(out, match_code - 15);
+    }
+}
+
+// Reads an extra length; returns false if the input runs out.
+bool GetExtraLength(const char*& p, const char* end, size_t* length) {
+    while (true) {
+        if (p == end) {
+            return false;
+        }
+        const auto byte = static_cast<uint8_t>(*p++);
+        *length += byte;
+        if (byte != 255) {
+            return true;
+        }
+    }
+}
+
+}  // namespace
+
+void CompressBlock(std::string_view input, std::string* out) {
+    const char* base = input.data();
+    const size_t n = input.size();
+    out->reserve(out->size() + n + n / 255 + 16);
+
+    std::vector<int32_t> table(size_t{1} << kHashBits, -1);
+    size_t anchor = 0;
+    size_t pos = 0;
+    while (pos + kMinMatch <= n) {
+        const uint32_t sequence = Load32(base + pos);
+        int32_t& slot = table[Hash(sequence)];
+        const int32_t candidate = slot;
+        slot = static_cast<int32_t>(pos);
+        if (candidate < 0 || pos - static_cast<size_t>(candidate) > kMaxOffset ||
+            Load32(base + candidate) != sequence) {
+            // Skip faster through data that keeps failing to match.
+            pos += 1 + ((pos - anchor) >> 6);
+            continue;
+        }
+
+        size_t length = kMinMatch;
+        while (pos + length < n && base[candidate + length] == base[pos + length]) {
+            ++length;
+        }
+        PutSequence(out, input.substr(anchor, pos - anchor), pos - static_cast<size_t>(candidate), length);
+        pos += length;
+        anchor = pos;
+    }
+    PutSequence(out, input.substr(anchor), 0, 0);
+}
+
+bool DecompressBlock(std::string_view input, size_t raw_size, std::string* out) {
+    const size_t start = out->size();
+    out->resize(start + raw_size);
+    char* dst = out->data() + start;
+    char* const dst_end = dst + raw_size;
+    const char* p = input.data();
+    const char* const end = p + input.size();
+
+    auto fail = [&]() {
+        out->resize(start);
+        return false;
+    };
+    while (true) {
+        if (p == end) {
+            return fail();
+        }
+        const auto token = static_cast<uint8_t>(*p++);
+        size_t literal_length = token >> 4;
+        if (literal_length == 15 && !GetExtraLength(p, end, &literal_length)) {
+            return fail();
+        }
+        if (literal_length > static_cast<size_t>(end - p) || literal_length > static_cast<size_t>(dst_end - dst)) {
+            return fail();
+        }
+        std::memcpy(dst, p, literal_length);
+        dst += literal_length;
+        p += literal_length;
+        if (p == end) {
+            break;
+        }
+
+        if (end - p < 2) {
+            return fail();
+        }
+        const size_t offset = static_cast<uint8_t>(p[0]) | (static_cast<size_t>(static_cast<uint8_t>(p[1])) << 8);
+        p += 2;
+        size_t match_length = token & 15;
+        if (match_length == 15 && !GetExtraLength(p, end, &match_length)) {
+            return fail();
+        }
+        match_length += kMinMatch;
+        const size_t produced = static_cast<size_t>(dst - (out->data() + start));
+        if (offset == 0 || offset > produced || match_length > static_cast<size_t>(dst_end - dst)) {
+            return fail();
+        }
+        const char* src = dst - offset;
+        if (offset >= match_length) {
+            std::memcpy(dst, src, match_length);
+        } else {
+            // Overlapping copy repeats the last offset bytes.
+            for (size_t i = 0; i < match_length; ++i) {
+                dst[i] = src[i];
+            }
+        }
+        dst += match_length;
+    }
+    if (dst != dst_end) {
+        return fail();
+    }
+    return true;
+}
+
+}  // namespace utils
+}  // namespace cpp_utils
@@ -0,0 +1,43 @@
+/**
+ * @file block_codec.h
+ * @brief A small, fast LZ77 block compressor in the style of LZ4.
+ */
+
+#ifndef CPP_UTILS_LIB_SRC_UTILS_BLOCK_CODEC_H_
+#define CPP_UTILS_LIB_SRC_UTILS_BLOCK_CODEC_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace cpp_utils {
+namespace utils {
+
+/**
+ * @brief Compresses a block of data and appends the result to out.
+ *
+ * The output is a sequence of (literals, match) pairs: a token byte holding
+ * 4-bit literal and match lengths, extra length bytes when either is 15 or
+ * more, the literals, and a 2-byte little-endian match offset. The last
+ * sequence has literals only. Matches are found greedily through a hash of
+ * 4-byte prefixes, trading ratio for speed; incompressible data grows by
+ * less than 1%.
+ *
+ * @param input The data to compress.
+ * @param out Receives the compressed bytes; existing contents are kept.
+ */
+void CompressBlock(std::string_view input, std::string* out);
+
+/**
+ * @brief Decompresses a block produced by CompressBlock and appends it to out.
+ * @param input The compressed bytes.
+ * @param raw_size The exact size of the decompressed data.
+ * @param out Receives the decompressed bytes; existing contents are kept.
+ * @return True on success, false if the input is corrupt or does not match raw_size.
+ */
+bool DecompressBlock(std::string_view input, size_t raw_size, std::string* out);
+
+}  // namespace utils
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_SRC_UTILS_BLOCK_CODEC_H_
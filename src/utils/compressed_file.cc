@@ -0,0 +1,556 @@
+#include "src/utils/compressed_file.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include "src/utils/block_codec.h"
+#include "src/utils/file_utils.h"
+#include "src/utils/varint.h"
+
+#ifdef CPP_UTILS_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+namespace cpp_utils {
+namespace utils {
+
+// Compresses appended bytes and hands the output to an AppendWriter.
+class CompressedWriter::Encoder {
+public:
+    virtual ~Encoder() = default;
+    virtual bool Write(std::string_view data, AppendWriter* file) = 0;
+    // Makes everything written so far decodable from the file.
+    virtual bool Flush(AppendWriter* file) = 0;
+    // Ends the stream; called once, by Close().
+    virtual bool Finish(AppendWriter* file) = 0;
+};
+
+// Produces uncompressed bytes on demand.
+class CompressedReader::Decoder {
+public:
+    virtual ~Decoder() = default;
+    virtual std::optional<size_t> Read(char* buffer, size_t capacity) = 0;
+};
+
+namespace {
+
+// Starts every stream in the built-in block format.
+constexpr std::string_view kBlockMagic("\x89" "CZB", 4);
+constexpr std::string_view kGzipMagic("\x1f\x8b", 2);
+// Raw bytes per block; also the largest block a reader accepts.
+constexpr size_t kBlockSize = 256 << 10;
+constexpr size_t kReadChunk = 256 << 10;
+
+// Buffered access to the raw bytes of a file.
+class Source {
+public:
+    explicit Source(int fd) : fd_(fd) {}
+
+    ~Source() { ::close(fd_); }
+
+    Source(const Source&) = delete;
+    Source& operator=(const Source&) = delete;
+
+    // Buffers at least n unread bytes, or everything up to end of file.
+    // Returns false on a read error.
+    bool Fill(size_t n) {
+        if (buffer_.size() - pos_ >= n || eof_) {
+            return true;
+        }
+        buffer_.erase(0, pos_);
+        pos_ = 0;
+        while (buffer_.size() < n && !eof_) {
+            const size_t old_size = buffer_.size();
+            buffer_.resize(std::max(n, old_size + kReadChunk));
+            const ssize_t got = ::read(fd_, buffer_.data() + old_size, buffer_.size() - old_size);
+            buffer_.resize(old_size + static_cast<size_t>(std::max<ssize_t>(got, 0)));
+            if (got < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            eof_ = got == 0;
+        }
+        return true;
+    }
+
+    std::string_view Available() const { return std::string_view(buffer_).substr(pos_); }
+
+    void Consume(size_t n) { pos_ += n; }
+
+    // Reads directly into buffer once the buffered bytes are used up.
+    std::optional<size_t> ReadThrough(char* buffer, size_t capacity) {
+        const std::string_view available = Available();
+        if (!available.empty()) {
+            const size_t n = std::min(capacity, available.size());
+            std::memcpy(buffer, available.data(), n);
+            Consume(n);
+            return n;
+        }
+        while (true) {
+            const ssize_t got = ::read(fd_, buffer, capacity);
+            if (got >= 0) {
+                return static_cast<size_t>(got);
+            }
+            if (errno != EINTR) {
+                return std::nullopt;
+            }
+        }
+    }
+
+private:
+    const int fd_;
+    std::string buffer_;
+    size_t pos_ = 0;
+    bool eof_ = false;
+};
+
+class RawEncoder : public CompressedWriter::Encoder {
+public:
+    bool Write(std::string_view data, AppendWriter* file) override { return file->Append(data); }
+    bool Flush(AppendWriter* file) override { return file->Flush(); }
+    bool Finish(AppendWriter* file) override { return file->Flush(); }
+};
+
+class RawDecoder : public CompressedReader::Decoder {
+public:
+    explicit RawDecoder(std::unique_ptr<Source> source) : source_(std::move(source)) {}
+
+    std::optional<size_t> Read(char* buffer, size_t capacity) override {
+        return source_->ReadThrough(buffer, capacity);
+    }
+
+private:
+    std::unique_ptr<Source> source_;
+};
+
+// Block stream layout: the magic, then blocks of
+//   varint raw_size, varint (stored_size << 1 | compressed), stored bytes,
+// and a raw_size of 0 to end the stream. Blocks that do not shrink are
+// stored as they are. Streams may follow each other in one file.
+class BlockEncoder : public CompressedWriter::Encoder {
+public:
+    bool Write(std::string_view data, AppendWriter* file) override {
+        while (!data.empty()) {
+            const size_t n = std::min(data.size(), kBlockSize - pending_.size());
+            pending_.append(data.data(), n);
+            data.remove_prefix(n);
+            if (pending_.size() == kBlockSize && !EmitBlock(file)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Flush(AppendWriter* file) override { return EmitBlock(file) && file->Flush(); }
+
+    bool Finish(AppendWriter* file) override {
+        if (!EmitBlock(file)) {
+            return false;
+        }
+        std::string end;
+        PutVarint64(&end, 0);
+        return file->Append(started_ ? std::string_view(end) : std::string_view()) && file->Flush();
+    }
+
+private:
+    bool EmitBlock(AppendWriter* file) {
+        if (pending_.empty()) {
+            return true;
+        }
+        compressed_.clear();
+        CompressBlock(pending_, &compressed_);
+        const bool use_compressed = compressed_.size() < pending_.size();
+        const std::string_view stored = use_compressed ? std::string_view(compressed_) : std::string_view(pending_);
+
+        header_.clear();
+        if (!started_) {
+            header_.append(kBlockMagic);
+            started_ = true;
+        }
+        PutVarint64(&header_, pending_.size());
+        PutVarint64(&header_, (static_cast<uint64_t>(stored.size()) << 1) | (use_compressed ? 1 : 0));
+        const bool ok = file->Append({header_, stored});
+        pending_.clear();
+        return ok;
+    }
+
+    bool started_ = false;
+    std::string pending_;
+    std::string compressed_;
+    std::string header_;
+};
+
+class BlockDecoder : public CompressedReader::Decoder {
+public:
+    explicit BlockDecoder(std::unique_ptr<Source> source) : source_(std::move(source)) {}
+
+    std::optional<size_t> Read(char* buffer, size_t capacity) override {
+        while (block_pos_ == block_.size()) {
+            if (corrupt_) {
+                return std::nullopt;
+            }
+            if (!NextBlock()) {
+                return corrupt_ ? std::nullopt : std::optional<size_t>(0);
+            }
+        }
+        const size_t n = std::min(capacity, block_.size() - block_pos_);
+        std::memcpy(buffer, block_.data() + block_pos_, n);
+        block_pos_ += n;
+        return n;
+    }
+
+private:
+    // Loads the next block; returns false at end of file or on corruption.
+    bool NextBlock() {
+        while (true) {
+            if (!source_->Fill(kBlockMagic.size() + 2 * kMaxVarint64Bytes)) {
+                corrupt_ = true;
+                return false;
+            }
+            std::string_view input = source_->Available();
+            if (input.empty()) {
+                // A stream cut off at a block boundary (e.g. by a crash) still reads cleanly.
+                return false;
+            }
+            if (expect_magic_) {
+                if (input.substr(0, kBlockMagic.size()) != kBlockMagic) {
+                    corrupt_ = true;
+                    return false;
+                }
+                source_->Consume(kBlockMagic.size());
+                expect_magic_ = false;
+                continue;
+            }
+
+            const size_t before = input.size();
+            uint64_t raw_size = 0;
+            uint64_t stored_info = 0;
+            if (!GetVarint64(&input, &raw_size)) {
+                corrupt_ = true;
+                return false;
+            }
+            if (raw_size == 0) {
+                source_->Consume(before - input.size());
+                expect_magic_ = true;
+                continue;
+            }
+            if (!GetVarint64(&input, &stored_info) || raw_size > kBlockSize ||
+                (stored_info >> 1) > kBlockSize + kBlockSize / 64 + 16) {
+                corrupt_ = true;
+                return false;
+            }
+            const size_t stored = static_cast<size_t>(stored_info >> 1);
+            source_->Consume(before - input.size());
+            if (!source_->Fill(stored) || source_->Available().size() < stored) {
+                corrupt_ = true;
+                return false;
+            }
+
+            const std::string_view payload = source_->Available().substr(0, stored);
+            block_.clear();
+            block_pos_ = 0;
+            if (stored_info & 1) {
+                if (!DecompressBlock(payload, static_cast<size_t>(raw_size), &block_)) {
+                    corrupt_ = true;
+                    return false;
+                }
+            } else if (stored == raw_size) {
+                block_.assign(payload.data(), payload.size());
+            } else {
+                corrupt_ = true;
+                return false;
+            }
+            source_->Consume(stored);
+            return true;
+        }
+    }
+
+    std::unique_ptr<Source> source_;
+    std::string block_;
+    size_t block_pos_ = 0;
+    bool expect_magic_ = true;
+    bool corrupt_ = false;
+};
+
+#ifdef CPP_UTILS_WITH_ZLIB
+
+constexpr size_t kZlibChunk = 64 << 10;
+
+class GzipEncoder : public CompressedWriter::Encoder {
+public:
+    GzipEncoder() {
+        std::memset(&stream_, 0, sizeof(stream_));
+        // 15 + 16 selects the gzip wrapper with the largest window.
+        ok_ = deflateInit2(&stream_, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+        out_.resize(kZlibChunk);
+    }
+
+    ~GzipEncoder() override {
+        if (ok_) {
+            deflateEnd(&stream_);
+        }
+    }
+
+    bool Initialized() const { return ok_; }
+
+    bool Write(std::string_view data, AppendWriter* file) override { return Deflate(data, Z_NO_FLUSH, file); }
+
+    bool Flush(AppendWriter* file) override { return Deflate({}, Z_SYNC_FLUSH, file) && file->Flush(); }
+
+    bool Finish(AppendWriter* file) override { return Deflate({}, Z_FINISH, file) && file->Flush(); }
+
+private:
+    bool Deflate(std::string_view data, int flush, AppendWriter* file) {
+        stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+        stream_.avail_in = static_cast<uInt>(data.size());
+        while (true) {
+            stream_.next_out = reinterpret_cast<Bytef*>(out_.data());
+            stream_.avail_out = static_cast<uInt>(out_.size());
+            const int result = deflate(&stream_, flush);
+            if (result == Z_STREAM_ERROR) {
+                return false;
+            }
+            const size_t produced = out_.size() - stream_.avail_out;
+            if (produced > 0 && !file->Append(std::string_view(out_.data(), produced))) {
+                return false;
+            }
+            // deflate is done once it leaves output space unused with no input left.
+            if (stream_.avail_out != 0 && stream_.avail_in == 0) {
+                return flush != Z_FINISH || result == Z_STREAM_END;
+            }
+        }
+    }
+
+    z_stream stream_;
+    bool ok_ = false;
+    std::string out_;
+};
+
+class GzipDecoder : public CompressedReader::Decoder {
+public:
+    explicit GzipDecoder(std::unique_ptr<Source> source) : source_(std::move(source)) {
+        std::memset(&stream_, 0, sizeof(stream_));
+        // 15 + 32 accepts both gzip and zlib headers.
+        ok_ = inflateInit2(&stream_, 15 + 32) == Z_OK;
+    }
+
+    ~GzipDecoder() override {
+        if (ok_) {
+            inflateEnd(&stream_);
+        }
+    }
+
+    std::optional<size_t> Read(char* buffer, size_t capacity) override {
+        if (!ok_) {
+            return std::nullopt;
+        }
+        const auto want = static_cast<uInt>(std::min<size_t>(capacity, 1u << 30));
+        if (want == 0) {
+            return 0;
+        }
+        stream_.next_out = reinterpret_cast<Bytef*>(buffer);
+        stream_.avail_out = want;
+        while (stream_.avail_out == want) {
+            if (!source_->Fill(1)) {
+                return std::nullopt;
+            }
+            const std::string_view input = source_->Available();
+            if (input.empty()) {
+                // A member cut off mid-stream is corrupt; a clean end is not.
+                if (!member_done_) {
+                    return std::nullopt;
+                }
+                break;
+            }
+            if (member_done_) {
+                // Concatenated members, e.g. from appending to a gzip file.
+                inflateReset(&stream_);
+                member_done_ = false;
+            }
+            stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+            stream_.avail_in = static_cast<uInt>(std::min<size_t>(input.size(), 1u << 30));
+            const uInt before = stream_.avail_in;
+            const int result = inflate(&stream_, Z_NO_FLUSH);
+            source_->Consume(before - stream_.avail_in);
+            if (result == Z_STREAM_END) {
+                member_done_ = true;
+            } else if (result != Z_OK && result != Z_BUF_ERROR) {
+                return std::nullopt;
+            }
+        }
+        return want - stream_.avail_out;
+    }
+
+private:
+    std::unique_ptr<Source> source_;
+    z_stream stream_;
+    bool ok_ = false;
+    bool member_done_ = true;  // No member has started yet.
+};
+
+#endif  // CPP_UTILS_WITH_ZLIB
+
+}  // namespace
+
+bool CompressionAvailable(Compression compression) {
+    switch (compression) {
+        case Compression::kNone:
+        case Compression::kBlock:
+            return true;
+        case Compression::kGzip:
+#ifdef CPP_UTILS_WITH_ZLIB
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+std::unique_ptr<CompressedWriter> CompressedWriter::Open(const std::filesystem::path& filename,
+                                                         Compression compression, const AppendOptions& options) {
+    std::unique_ptr<Encoder> encoder;
+    switch (compression) {
+        case Compression::kNone:
+            encoder = std::make_unique<RawEncoder>();
+            break;
+        case Compression::kBlock:
+            encoder = std::make_unique<BlockEncoder>();
+            break;
+        case Compression::kGzip: {
+#ifdef CPP_UTILS_WITH_ZLIB
+            auto gzip = std::make_unique<GzipEncoder>();
+            if (gzip->Initialized()) {
+                encoder = std::move(gzip);
+            }
+#endif
+            break;
+        }
+    }
+    if (!encoder) {
+        return nullptr;
+    }
+    auto file = AppendWriter::Open(filename, options);
+    if (!file) {
+        return nullptr;
+    }
+    return std::unique_ptr<CompressedWriter>(new CompressedWriter(std::move(file), std::move(encoder)));
+}
+
+CompressedWriter::CompressedWriter(std::unique_ptr<AppendWriter> file, std::unique_ptr<Encoder> encoder)
+    : file_(std::move(file)), encoder_(std::move(encoder)) {}
+
+CompressedWriter::~CompressedWriter() {
+    if (!closed_) {
+        Close();
+    }
+}
+
+bool CompressedWriter::Append(std::string_view data) {
+    return !closed_ && encoder_->Write(data, file_.get());
+}
+
+bool CompressedWriter::Flush() {
+    return !closed_ && encoder_->Flush(file_.get());
+}
+
+bool CompressedWriter::Sync() {
+    return !closed_ && encoder_->Flush(file_.get()) && file_->Sync();
+}
+
+bool CompressedWriter::Close() {
+    if (closed_) {
+        return false;
+    }
+    closed_ = true;
+    return encoder_->Finish(file_.get());
+}
+
+std::unique_ptr<CompressedReader> CompressedReader::Open(const std::filesystem::path& filename) {
+    const int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    auto source = std::make_unique<Source>(fd);
+    if (!source->Fill(kBlockMagic.size())) {
+        return nullptr;
+    }
+
+    const std::string_view head = source->Available();
+    Compression format = Compression::kNone;
+    std::unique_ptr<Decoder> decoder;
+    if (head.substr(0, kBlockMagic.size()) == kBlockMagic) {
+        format = Compression::kBlock;
+        decoder = std::make_unique<BlockDecoder>(std::move(source));
+    } else if (head.substr(0, kGzipMagic.size()) == kGzipMagic) {
+        format = Compression::kGzip;
+#ifdef CPP_UTILS_WITH_ZLIB
+        decoder = std::make_unique<GzipDecoder>(std::move(source));
+#else
+        return nullptr;
+#endif
+    } else {
+        decoder = std::make_unique<RawDecoder>(std::move(source));
+    }
+    return std::unique_ptr<CompressedReader>(new CompressedReader(format, std::move(decoder)));
+}
+
+CompressedReader::CompressedReader(Compression format, std::unique_ptr<Decoder> decoder)
+    : format_(format), decoder_(std::move(decoder)) {}
+
+CompressedReader::~CompressedReader() = default;
+
+std::optional<size_t> CompressedReader::Read(char* buffer, size_t capacity) {
+    return decoder_->Read(buffer, capacity);
+}
+
+std::optional<LineReader> OpenCompressedLines(const std::filesystem::path& filename, size_t buffer_size) {
+    std::shared_ptr<CompressedReader> reader = CompressedReader::Open(filename);
+    if (!reader) {
+        return std::nullopt;
+    }
+    return LineReader(
+        [reader](char* buffer, size_t capacity) { return reader->Read(buffer, capacity); },
+        buffer_size);
+}
+
+std::optional<std::string> ReadCompressedFile(const std::filesystem::path& filename) {
+    auto reader = CompressedReader::Open(filename);
+    if (!reader) {
+        return std::nullopt;
+    }
+    std::string contents;
+    size_t size = 0;
+    while (true) {
+        contents.resize(size + kReadChunk);
+        const std::optional<size_t> n = reader->Read(contents.data() + size, kReadChunk);
+        if (!n) {
+            return std::nullopt;
+        }
+        if (*n == 0) {
+            break;
+        }
+        size += *n;
+    }
+    contents.resize(size);
+    return contents;
+}
+
+bool WriteCompressedFile(const std::filesystem::path& filename, std::string_view data, Compression compression) {
+    if (!CompressionAvailable(compression) || !WriteFile(filename, "")) {
+        return false;
+    }
+    auto writer = CompressedWriter::Open(filename, compression);
+    return writer && writer->Append(data) && writer->Close();
+}
+
+}  // namespace utils
+}  // namespace cpp_utils
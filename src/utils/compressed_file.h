@@ -0,0 +1,183 @@
+/**
+ * @file compressed_file.h
+ * @brief Streaming reads and writes of compressed files.
+ */
+
+#ifndef CPP_UTILS_LIB_SRC_UTILS_COMPRESSED_FILE_H_
+#define CPP_UTILS_LIB_SRC_UTILS_COMPRESSED_FILE_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "src/utils/append_writer.h"
+#include "src/utils/line_reader.h"
+
+namespace cpp_utils {
+namespace utils {
+
+/**
+ * @brief File compression formats.
+ *
+ * kBlock is the built-in format: independent blocks compressed with
+ * CompressBlock. kGzip needs zlib and is only available when built with
+ * CPP_UTILS_WITH_ZLIB defined (and -lz linked).
+ */
+enum class Compression {
+    kNone,
+    kBlock,
+    kGzip,
+};
+
+/**
+ * @brief Checks whether a format was compiled in.
+ * @param compression The format.
+ * @return True if files in this format can be read and written.
+ */
+bool CompressionAvailable(Compression compression);
+
+/**
+ * @brief Writes a compressed file incrementally through an AppendWriter.
+ *
+ * Data is compressed as it is appended and the compressed bytes are
+ * appended to the file, so memory use is bounded by one block. Opening an
+ * existing file appends a new compressed stream after the old one, which
+ * the reader follows transparently. Close() ends the stream and reports
+ * whether its tail reached the file; the destructor closes the writer if
+ * that has not happened yet, but cannot report failure.
+ */
+class CompressedWriter {
+public:
+    /**
+     * @brief Opens a file for appending compressed data, creating it if necessary.
+     * @param filename The path to the file.
+     * @param compression The format to write.
+     * @param options Buffering and durability of the underlying AppendWriter.
+     * @return The writer, or nullptr if the file could not be opened or the format is unavailable.
+     */
+    static std::unique_ptr<CompressedWriter> Open(const std::filesystem::path& filename, Compression compression,
+                                                  const AppendOptions& options = AppendOptions());
+
+    CompressedWriter(const CompressedWriter&) = delete;
+    CompressedWriter& operator=(const CompressedWriter&) = delete;
+
+    ~CompressedWriter();
+
+    /**
+     * @brief Appends uncompressed data.
+     * @param data The bytes to compress and append.
+     * @return True if the operation was successful, false otherwise.
+     */
+    bool Append(std::string_view data);
+
+    /**
+     * @brief Compresses everything appended so far and writes it to the file.
+     *
+     * Flushing often costs compression ratio, since each flush ends a block.
+     *
+     * @return True if the operation was successful, false otherwise.
+     */
+    bool Flush();
+
+    /**
+     * @brief Flushes, then waits until the data is on stable storage.
+     * @return True if the operation was successful, false otherwise.
+     */
+    bool Sync();
+
+    /**
+     * @brief Ends the stream and hands everything to the kernel.
+     *
+     * Writes whatever the format puts at the end of a stream, such as the
+     * gzip trailer. Afterwards the writer accepts no more data, and further
+     * calls return false.
+     *
+     * @return True if the operation was successful, false otherwise.
+     */
+    bool Close();
+
+    class Encoder;
+
+private:
+    CompressedWriter(std::unique_ptr<AppendWriter> file, std::unique_ptr<Encoder> encoder);
+
+    std::unique_ptr<AppendWriter> file_;
+    std::unique_ptr<Encoder> encoder_;
+    bool closed_ = false;
+};
+
+/**
+ * @brief Reads a possibly compressed file as a stream of uncompressed bytes.
+ *
+ * The format is detected from the first bytes, so plain files are read as
+ * they are.
+ */
+class CompressedReader {
+public:
+    /**
+     * @brief Opens a file for reading.
+     * @param filename The path to the file.
+     * @return The reader, or nullptr if the file could not be opened or its format is unavailable.
+     */
+    static std::unique_ptr<CompressedReader> Open(const std::filesystem::path& filename);
+
+    CompressedReader(const CompressedReader&) = delete;
+    CompressedReader& operator=(const CompressedReader&) = delete;
+
+    ~CompressedReader();
+
+    /**
+     * @brief Reads the next uncompressed bytes; suitable as a LineReader::ReadFunction.
+     * @param buffer Where the bytes go.
+     * @param capacity The maximum number of bytes to read.
+     * @return The number of bytes read (0 at end of file), or std::nullopt if the file is corrupt.
+     */
+    std::optional<size_t> Read(char* buffer, size_t capacity);
+
+    /**
+     * @brief Gets the detected format.
+     * @return The format of the file.
+     */
+    Compression Format() const { return format_; }
+
+    class Decoder;
+
+private:
+    CompressedReader(Compression format, std::unique_ptr<Decoder> decoder);
+
+    const Compression format_;
+    std::unique_ptr<Decoder> decoder_;
+};
+
+/**
+ * @brief Streams the lines of a possibly compressed file.
+ * @param filename The path to the file.
+ * @param buffer_size The initial line buffer size.
+ * @return An optional containing the reader if the file could be opened, or std::nullopt otherwise.
+ */
+std::optional<LineReader> OpenCompressedLines(const std::filesystem::path& filename,
+                                              size_t buffer_size = LineReader::kDefaultBufferSize);
+
+/**
+ * @brief Reads and decompresses an entire file.
+ * @param filename The path to the file.
+ * @return An optional containing the uncompressed contents if successful, or std::nullopt otherwise.
+ */
+std::optional<std::string> ReadCompressedFile(const std::filesystem::path& filename);
+
+/**
+ * @brief Compresses data into a file, overwriting any existing content.
+ * @param filename The path to the file.
+ * @param data The uncompressed data.
+ * @param compression The format to write.
+ * @return True if the operation was successful, false otherwise.
+ */
+bool WriteCompressedFile(const std::filesystem::path& filename, std::string_view data, Compression compression);
+
+}  // namespace utils
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_SRC_UTILS_COMPRESSED_FILE_H_
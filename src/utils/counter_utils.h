@@ -6,7 +6,22 @@
 #ifndef CPP_UTILS_LIB_SRC_UTILS_COUNTER_UTILS_H_
 #define CPP_UTILS_LIB_SRC_UTILS_COUNTER_UTILS_H_
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <map>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "src/utils/file_utils.h"
+#include "src/utils/varint.h"
 
 namespace cpp_utils::utils {
 
@@ -30,6 +45,32 @@ public:
         */
     void Count(const Value& value) { count_map_[key_extractor_(value)]++; }
 
+    /**
+        * @description: 直接按key累加计数，计数变为0的key会被移除
+        * @param key: 要累加的key
+        * @param delta: 累加的数量，可以为负数
+        */
+    void Add(const Key& key, int32_t delta = 1)
+    {
+        auto it = count_map_.try_emplace(key, 0).first;
+        it->second += delta;
+        if (it->second == 0) {
+            count_map_.erase(it);
+        }
+    }
+
+    /**
+        * @description: 使用key_extractor_从元素中提取key
+        * @param value: 元素
+        * @return: 提取出的key
+        */
+    Key ExtractKey(const Value& value) const { return key_extractor_(value); }
+
+    /**
+        * @description: 清空统计结果
+        */
+    void Clear() { count_map_.clear(); }
+
     /**
         * @description: 获取统计结果，返回<成员类型Key，int32_t>映射
         * @return: 统计结果
@@ -44,11 +85,321 @@ public:
         }
         return ret;
     }
+
+    /**
+        * @description: 合并另一个计数器的统计结果，相同key的计数相加
+        * @param other: 要合并的计数器
+        */
+    void Merge(const CounterTp& other)
+    {
+        MergeMap(other.count_map_, 1);
+    }
+
+    /**
+        * @description: 减去另一个计数器的统计结果，计数变为0的key会被移除
+        * @param other: 要减去的计数器
+        */
+    void Subtract(const CounterTp& other)
+    {
+        MergeMap(other.count_map_, -1);
+    }
+
+    /**
+        * @description: 将统计结果序列化为紧凑的二进制快照
+        *   格式: 版本号 | 条目数(varint) | 按key有序排列的条目
+        *   整数key存储与前一个key的差值(varint)，字符串key存储与前一个key的公共前缀长度和剩余后缀，
+        *   计数使用zigzag varint编码
+        * @return: 二进制快照
+        */
+    std::string Serialize() const
+    {
+        std::string out;
+        out.push_back(static_cast<char>(kSnapshotVersion));
+        utils::PutVarint64(&out, count_map_.size());
+        const Key* prev = nullptr;
+        for (auto&& [key, count]: count_map_)
+        {
+            EncodeKey(&out, prev, key);
+            utils::PutVarint64(&out, utils::ZigZagEncode(count));
+            prev = &key;
+        }
+        return out;
+    }
+
+    /**
+        * @description: 用二进制快照替换当前统计结果，解析失败时保持原结果不变
+        * @param data: Serialize()生成的快照
+        * @return: 解析成功返回true
+        */
+    bool Deserialize(std::string_view data)
+    {
+        std::map<Key, int32_t> parsed;
+        if (!ParseSnapshot(data, &parsed)) {
+            return false;
+        }
+        count_map_.swap(parsed);
+        return true;
+    }
+
+    /**
+        * @description: 将二进制快照直接合并到当前统计结果中，用于跨进程聚合
+        * @param data: Serialize()生成的快照
+        * @return: 解析成功返回true，失败时保持原结果不变
+        */
+    bool MergeSerialized(std::string_view data)
+    {
+        std::map<Key, int32_t> parsed;
+        if (!ParseSnapshot(data, &parsed)) {
+            return false;
+        }
+        MergeMap(parsed, 1);
+        return true;
+    }
+
+    /**
+        * @description: 将二进制快照写入文件
+        * @param filename: 文件路径
+        * @return: 写入成功返回true
+        */
+    bool SaveToFile(const std::filesystem::path& filename) const
+    {
+        return utils::WriteFile(filename, Serialize());
+    }
+
+    /**
+        * @description: 从文件读取二进制快照并替换当前统计结果
+        * @param filename: 文件路径
+        * @return: 读取并解析成功返回true
+        */
+    bool LoadFromFile(const std::filesystem::path& filename)
+    {
+        auto data = utils::ReadFile(filename);
+        return data.has_value() && Deserialize(*data);
+    }
+
 private:
+    static constexpr uint8_t kSnapshotVersion = 1;
+
+    static constexpr bool kIntegralKey = std::is_integral_v<Key>;
+    static constexpr bool kStringKey = std::is_same_v<Key, std::string>;
+
+    void MergeMap(const std::map<Key, int32_t>& other, int32_t sign)
+    {
+        if (&other == &count_map_) {
+            // 与自身合并时不能边遍历边删除：相减全部归零，相加每个计数翻倍
+            if (sign < 0) {
+                count_map_.clear();
+            } else {
+                for (auto& [key, count]: count_map_) {
+                    count *= 2;
+                }
+            }
+            return;
+        }
+        auto hint = count_map_.begin();
+        for (auto&& [key, count]: other)
+        {
+            hint = count_map_.try_emplace(hint, key, 0);
+            hint->second += sign * count;
+            if (hint->second == 0) {
+                hint = count_map_.erase(hint);
+            }
+        }
+    }
+
+    static void EncodeKey(std::string* out, const Key* prev, const Key& key)
+    {
+        static_assert(kIntegralKey || kStringKey, "snapshot keys must be integral or std::string");
+        if constexpr (kIntegralKey) {
+            // 有序key之间的差值非负，按无符号回绕运算即可覆盖完整取值范围
+            const uint64_t base = prev ? static_cast<uint64_t>(*prev) : 0;
+            utils::PutVarint64(out, static_cast<uint64_t>(key) - base);
+        } else {
+            size_t shared = 0;
+            if (prev) {
+                const size_t limit = std::min(prev->size(), key.size());
+                while (shared < limit && (*prev)[shared] == key[shared]) {
+                    ++shared;
+                }
+            }
+            utils::PutVarint64(out, shared);
+            utils::PutVarint64(out, key.size() - shared);
+            out->append(key, shared, std::string::npos);
+        }
+    }
+
+    static bool DecodeKey(std::string_view* input, const Key* prev, Key* key)
+    {
+        static_assert(kIntegralKey || kStringKey, "snapshot keys must be integral or std::string");
+        if constexpr (kIntegralKey) {
+            uint64_t delta = 0;
+            if (!utils::GetVarint64(input, &delta)) {
+                return false;
+            }
+            const uint64_t base = prev ? static_cast<uint64_t>(*prev) : 0;
+            *key = static_cast<Key>(base + delta);
+            return true;
+        } else {
+            uint64_t shared = 0;
+            uint64_t suffix = 0;
+            if (!utils::GetVarint64(input, &shared) || !utils::GetVarint64(input, &suffix)) {
+                return false;
+            }
+            const size_t prev_size = prev ? prev->size() : 0;
+            if (shared > prev_size || suffix > input->size()) {
+                return false;
+            }
+            key->assign(prev ? prev->data() : "", shared);
+            key->append(input->data(), suffix);
+            input->remove_prefix(suffix);
+            return true;
+        }
+    }
+
+    static bool ParseSnapshot(std::string_view data, std::map<Key, int32_t>* out)
+    {
+        if (data.empty() || static_cast<uint8_t>(data.front()) != kSnapshotVersion) {
+            return false;
+        }
+        data.remove_prefix(1);
+        uint64_t entries = 0;
+        if (!utils::GetVarint64(&data, &entries)) {
+            return false;
+        }
+        const Key* prev = nullptr;
+        for (uint64_t i = 0; i < entries; ++i)
+        {
+            Key key{};
+            uint64_t count = 0;
+            if (!DecodeKey(&data, prev, &key) || !utils::GetVarint64(&data, &count)) {
+                return false;
+            }
+            // 快照按key有序写出，逐条追加到末尾即可
+            if (!out->empty() && !(out->rbegin()->first < key)) {
+                return false;
+            }
+            const int64_t value = utils::ZigZagDecode(count);
+            if (value < std::numeric_limits<int32_t>::min() || value > std::numeric_limits<int32_t>::max()) {
+                return false;
+            }
+            auto it = out->emplace_hint(out->end(), std::move(key), static_cast<int32_t>(value));
+            prev = &it->first;
+        }
+        return data.empty();
+    }
+
     KeyExtractor key_extractor_; // 提取key的函数
     std::map<Key, int32_t> count_map_; // 统计结果, 有序输出
 };
 
+/**
+    * @description: 滑动窗口计数器，只统计最近window时间内的元素，key的提取方式与CounterTp相同
+    *   窗口被划分为num_buckets个环形时间桶，每个桶记录自己时间片内的计数，另有一个总计数器。
+    *   时间前进时只需从总计数器中减去过期桶内的条目，每条计数在写入和过期时各处理一次，
+    *   不会重新扫描整个统计结果
+    * @tparam Key: 要统计的元素的成员类型
+    * @tparam Value: 统计的元素的类型
+    * @tparam Clock: 时钟类型，默认为steady_clock
+    */
+template<typename Key, typename Value, typename Clock = std::chrono::steady_clock>
+class WindowedCounterTp {
+public:
+    using KeyExtractor = typename CounterTp<Key, Value>::KeyExtractor;
+    using Duration = typename Clock::duration;
+    using TimePoint = typename Clock::time_point;
+
+    /**
+        * @description: 构造滑动窗口计数器
+        * @param key_extractor: 从元素中提取key的函数
+        * @param window: 窗口长度
+        * @param num_buckets: 时间桶数量，决定过期的时间粒度(window / num_buckets)
+        */
+    WindowedCounterTp(KeyExtractor key_extractor, Duration window, size_t num_buckets)
+        : total_(key_extractor),
+          buckets_(std::max<size_t>(num_buckets, 1), CounterTp<Key, Value>(key_extractor)),
+          bucket_width_(std::max<Duration>(window / static_cast<int64_t>(buckets_.size()), Duration(1))) {}
+
+    /**
+        * @description: 以当前时间统计一个元素
+        * @param value: 要统计的元素
+        */
+    void Count(const Value& value) { Count(value, Clock::now()); }
+
+    /**
+        * @description: 以指定时间统计一个元素，早于当前时间桶的时间点计入当前桶
+        * @param value: 要统计的元素
+        * @param now: 元素发生的时间
+        */
+    void Count(const Value& value, TimePoint now)
+    {
+        Advance(now);
+        const Key key = total_.ExtractKey(value);
+        buckets_[Slot(current_tick_)].Add(key);
+        total_.Add(key);
+    }
+
+    /**
+        * @description: 将窗口推进到指定时间，过期桶中的计数从总计数器中移除
+        * @param now: 当前时间
+        */
+    void Advance(TimePoint now)
+    {
+        const int64_t tick = now.time_since_epoch() / bucket_width_;
+        if (!started_) {
+            started_ = true;
+            current_tick_ = tick;
+            return;
+        }
+        if (tick <= current_tick_) {
+            return;
+        }
+        if (static_cast<uint64_t>(tick - current_tick_) >= buckets_.size()) {
+            // 整个窗口都已过期
+            for (auto& bucket: buckets_) {
+                bucket.Clear();
+            }
+            total_.Clear();
+        } else {
+            for (int64_t t = current_tick_ + 1; t <= tick; ++t) {
+                auto& bucket = buckets_[Slot(t)];
+                total_.Subtract(bucket);
+                bucket.Clear();
+            }
+        }
+        current_tick_ = tick;
+    }
+
+    /**
+        * @description: 获取窗口内的统计结果，调用前可先Advance以剔除过期计数
+        * @return: 统计结果
+        */
+    const auto& GetCountMap() const { return total_.GetCountMap(); }
+
+    /**
+        * @description: 获取窗口内的统计结果快照，可用于CounterTp::Merge等操作
+        * @return: 总计数器
+        */
+    const CounterTp<Key, Value>& GetCounter() const { return total_; }
+
+    /**
+        * @description: 获取实际窗口长度(时间桶宽度 * 桶数量)
+        * @return: 窗口长度
+        */
+    Duration Window() const { return bucket_width_ * static_cast<int64_t>(buckets_.size()); }
+
+private:
+    size_t Slot(int64_t tick) const
+    {
+        const auto n = static_cast<int64_t>(buckets_.size());
+        return static_cast<size_t>((tick % n + n) % n);
+    }
+
+    CounterTp<Key, Value> total_; // 窗口内的总计数
+    std::vector<CounterTp<Key, Value>> buckets_; // 环形时间桶
+    Duration bucket_width_; // 每个时间桶的时间跨度
+    int64_t current_tick_ = 0; // 当前时间桶的序号
+    bool started_ = false;
+};
 
 }  // namespace cpp_utils::utils
 
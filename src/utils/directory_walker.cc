@@ -0,0 +1,239 @@
+#include "src/utils/directory_walker.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+constexpr size_t kDirentBufferSize = 64 << 10;
+
+// The record layout returned by getdents64; glibc does not export it.
+struct LinuxDirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+
+struct PendingDirectory {
+    std::string path;
+    size_t depth;  // Depth of the entries inside this directory.
+};
+
+EntryType TypeFromMode(mode_t mode) {
+    if (S_ISREG(mode)) {
+        return EntryType::kFile;
+    }
+    if (S_ISDIR(mode)) {
+        return EntryType::kDirectory;
+    }
+    if (S_ISLNK(mode)) {
+        return EntryType::kSymlink;
+    }
+    return EntryType::kOther;
+}
+
+EntryType ResolveType(int dir_fd, const char* name, unsigned char d_type) {
+    switch (d_type) {
+        case DT_REG:
+            return EntryType::kFile;
+        case DT_DIR:
+            return EntryType::kDirectory;
+        case DT_LNK:
+            return EntryType::kSymlink;
+        case DT_UNKNOWN: {
+            struct stat st;
+            if (::fstatat(dir_fd, name, &st, AT_SYMLINK_NOFOLLOW) == 0) {
+                return TypeFromMode(st.st_mode);
+            }
+            return EntryType::kOther;
+        }
+        default:
+            return EntryType::kOther;
+    }
+}
+
+class Walker {
+public:
+    Walker(const EntryCallback& fn, const WalkOptions& options) : fn_(fn), options_(options) {}
+
+    // Reads one directory, reporting its entries and passing subdirectories
+    // to descend(). Returns false if the directory could not be opened.
+    template <typename Descend>
+    bool Scan(const PendingDirectory& dir, char* buffer, const Descend& descend) const {
+        const int fd = ::open(dir.path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        std::string path = dir.path;
+        if (path.empty() || path.back() != '/') {
+            path.push_back('/');
+        }
+        const size_t prefix = path.size();
+
+        while (true) {
+            const long bytes = ::syscall(SYS_getdents64, fd, buffer, kDirentBufferSize);
+            if (bytes <= 0) {
+                break;
+            }
+            for (long offset = 0; offset < bytes;) {
+                const auto* record = reinterpret_cast<const LinuxDirent64*>(buffer + offset);
+                offset += record->d_reclen;
+                const char* name = record->d_name;
+                if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+                    continue;
+                }
+                path.resize(prefix);
+                path.append(name);
+
+                DirEntry entry;
+                entry.path = path;
+                entry.name = std::string_view(path).substr(prefix);
+                entry.type = ResolveType(fd, name, record->d_type);
+                entry.depth = dir.depth;
+                if (options_.filter && !options_.filter(entry)) {
+                    continue;
+                }
+                fn_(entry);
+                if (entry.type == EntryType::kDirectory && dir.depth < options_.max_depth) {
+                    descend(PendingDirectory{path, dir.depth + 1});
+                }
+            }
+        }
+        ::close(fd);
+        return true;
+    }
+
+    bool WalkSequential(const std::string& root) const {
+        std::unique_ptr<char[]> buffer(new char[kDirentBufferSize]);
+        std::vector<PendingDirectory> stack;
+        auto push = [&stack](PendingDirectory dir) { stack.push_back(std::move(dir)); };
+        if (!Scan(PendingDirectory{root, 0}, buffer.get(), push)) {
+            return false;
+        }
+        while (!stack.empty()) {
+            PendingDirectory dir = std::move(stack.back());
+            stack.pop_back();
+            Scan(dir, buffer.get(), push);
+        }
+        return true;
+    }
+
+    bool WalkParallel(const std::string& root, size_t threads) {
+        // Scan the root on this thread so an unreadable root is reported.
+        std::unique_ptr<char[]> buffer(new char[kDirentBufferSize]);
+        auto push = [this](PendingDirectory dir) { Push(std::move(dir)); };
+        if (!Scan(PendingDirectory{root, 0}, buffer.get(), push)) {
+            return false;
+        }
+
+        std::vector<std::thread> pool;
+        for (size_t i = 1; i < threads; ++i) {
+            pool.emplace_back([this]() { Work(); });
+        }
+        Work();
+        for (auto& thread : pool) {
+            thread.join();
+        }
+        return true;
+    }
+
+private:
+    void Push(PendingDirectory dir) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(std::move(dir));
+        }
+        condition_.notify_one();
+    }
+
+    // Takes directories until the queue is empty and no worker can add more.
+    void Work() {
+        std::unique_ptr<char[]> buffer(new char[kDirentBufferSize]);
+        auto push = [this](PendingDirectory dir) { Push(std::move(dir)); };
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            condition_.wait(lock, [this]() { return !queue_.empty() || active_ == 0; });
+            if (queue_.empty()) {
+                break;
+            }
+            PendingDirectory dir = std::move(queue_.front());
+            queue_.pop_front();
+            ++active_;
+            lock.unlock();
+            Scan(dir, buffer.get(), push);
+            lock.lock();
+            --active_;
+        }
+        // Wake the others so they can see the walk is over.
+        condition_.notify_all();
+    }
+
+    const EntryCallback& fn_;
+    const WalkOptions& options_;
+    std::deque<PendingDirectory> queue_;
+    size_t active_ = 0;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+};
+
+}  // namespace
+
+bool WalkDirectory(const std::filesystem::path& root, const EntryCallback& fn, const WalkOptions& options) {
+    size_t threads = options.threads;
+    if (threads == 0) {
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    Walker walker(fn, options);
+    if (threads == 1) {
+        return walker.WalkSequential(root.string());
+    }
+    return walker.WalkParallel(root.string(), threads);
+}
+
+std::optional<std::vector<std::filesystem::path>> FindFiles(const std::filesystem::path& root,
+                                                           std::string_view extension, size_t threads) {
+    std::vector<std::filesystem::path> files;
+    std::mutex mutex;
+    WalkOptions options;
+    options.threads = threads;
+    const bool ok = WalkDirectory(
+        root,
+        [&](const DirEntry& entry) {
+            if (entry.type != EntryType::kFile) {
+                return;
+            }
+            if (!extension.empty()) {
+                const size_t dot = entry.name.rfind('.');
+                // Like std::filesystem::path::extension, a leading dot is not an extension.
+                if (dot == std::string_view::npos || dot == 0 || entry.name.substr(dot) != extension) {
+                    return;
+                }
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            files.emplace_back(entry.path);
+        },
+        options);
+    if (!ok) {
+        return std::nullopt;
+    }
+    return files;
+}
+
+}  // namespace utils
+}  // namespace cpp_utils
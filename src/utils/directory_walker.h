@@ -0,0 +1,88 @@
+/**
+ * @file directory_walker.h
+ * @brief Fast recursive directory traversal.
+ */
+
+#ifndef CPP_UTILS_LIB_SRC_UTILS_DIRECTORY_WALKER_H_
+#define CPP_UTILS_LIB_SRC_UTILS_DIRECTORY_WALKER_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace cpp_utils {
+namespace utils {
+
+/**
+ * @brief The kind of a directory entry, as reported by the file system.
+ */
+enum class EntryType {
+    kFile,
+    kDirectory,
+    kSymlink,
+    kOther,
+};
+
+/**
+ * @brief One entry found while walking; the views are valid only during the callback.
+ */
+struct DirEntry {
+    std::string_view path;  // The root joined with the entry's relative path.
+    std::string_view name;  // The last path component.
+    EntryType type;
+    size_t depth;           // 0 for entries directly inside the root.
+};
+
+/**
+ * @brief Settings for WalkDirectory.
+ */
+struct WalkOptions {
+    size_t threads = 1;  // Directories scanned concurrently; 0 means one per core.
+    size_t max_depth = std::numeric_limits<size_t>::max();  // Deepest level reported; 0 lists the root only.
+    // Entries for which this returns false are neither reported nor, for
+    // directories, descended into. Called concurrently when threads != 1.
+    std::function<bool(const DirEntry&)> filter;
+};
+
+/**
+ * @brief Called for every reported entry; called concurrently when threads != 1.
+ */
+using EntryCallback = std::function<void(const DirEntry&)>;
+
+/**
+ * @brief Walks a directory tree, reporting every entry below the root.
+ *
+ * Directories are read with getdents64 into a large buffer, and entry types
+ * come from d_type, so regular trees are walked without a stat per entry
+ * (file systems that do not fill in d_type fall back to fstatat). Symbolic
+ * links are reported but not followed. With several threads, subdirectories
+ * are handed out from a shared queue; the order of entries is unspecified.
+ * Subdirectories that cannot be opened are skipped.
+ *
+ * @param root The directory to walk.
+ * @param fn Called once per reported entry.
+ * @param options Parallelism, depth limit and filter.
+ * @return True if the root could be opened, false otherwise.
+ */
+bool WalkDirectory(const std::filesystem::path& root, const EntryCallback& fn,
+                   const WalkOptions& options = WalkOptions());
+
+/**
+ * @brief Recursively collects the regular files under a directory.
+ * @param root The directory to walk.
+ * @param extension Only files with this extension (e.g. ".txt") are kept; empty keeps all.
+ * @param threads Directories scanned concurrently; 0 means one per core.
+ * @return An optional containing the file paths if successful, or std::nullopt otherwise.
+ */
+std::optional<std::vector<std::filesystem::path>> FindFiles(const std::filesystem::path& root,
+                                                           std::string_view extension = {},
+                                                           size_t threads = 1);
+
+}  // namespace utils
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_SRC_UTILS_DIRECTORY_WALKER_H_
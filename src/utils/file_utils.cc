@@ -1,11 +1,85 @@
 #include "src/utils/file_utils.h"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <fstream>
 #include <iostream>
 #include <system_error>
 
 namespace cpp_utils {
 namespace utils {
+namespace {
+
+// Writes data with as few write calls as possible, resuming after short writes.
+bool WriteAll(int fd, std::string_view data) {
+    constexpr size_t kMaxChunk = 1 << 30;
+    while (!data.empty()) {
+        const ssize_t written = ::write(fd, data.data(), std::min(data.size(), kMaxChunk));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data.remove_prefix(static_cast<size_t>(written));
+    }
+    return true;
+}
+
+// Writes data into an open file and closes it.
+bool WriteAndClose(int fd, std::string_view data, const WriteOptions& options) {
+    if (options.preallocate && !data.empty()) {
+        // Best effort: not every file system supports fallocate.
+        ::fallocate(fd, 0, 0, static_cast<off_t>(data.size()));
+    }
+    bool ok = WriteAll(fd, data);
+    if (ok && (options.sync || options.atomic)) {
+        ok = ::fdatasync(fd) == 0;
+    }
+    return ::close(fd) == 0 && ok;
+}
+
+bool SyncDirectory(const std::filesystem::path& directory) {
+    const int fd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    const bool ok = ::fsync(fd) == 0;
+    ::close(fd);
+    return ok;
+}
+
+bool WriteFileAtomically(const std::filesystem::path& filename, std::string_view data,
+                         const WriteOptions& options) {
+    static std::atomic<uint64_t> counter{0};
+    std::filesystem::path temp = filename;
+    temp += ".tmp." + std::to_string(::getpid()) + "." + std::to_string(counter.fetch_add(1));
+
+    // A new file gets 0666 less the umask, like any other created file.
+    const int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+    if (fd < 0) {
+        return false;
+    }
+    // An existing target keeps its exact mode, which the umask may have narrowed.
+    struct stat st;
+    if (::stat(filename.c_str(), &st) == 0 && ::fchmod(fd, st.st_mode & 07777) != 0) {
+        ::close(fd);
+        ::unlink(temp.c_str());
+        return false;
+    }
+    if (!WriteAndClose(fd, data, options) || ::rename(temp.c_str(), filename.c_str()) != 0) {
+        ::unlink(temp.c_str());
+        return false;
+    }
+    return SyncDirectory(filename.parent_path());
+}
+
+}  // namespace
 
 std::optional<std::string> ReadFile(const std::filesystem::path& filename) {
     std::ifstream file(filename, std::ios::binary);
@@ -29,13 +103,18 @@ std::optional<std::string> ReadFile(const std::filesystem::path& filename) {
 }
 
 bool WriteFile(const std::filesystem::path& filename, std::string_view data) {
-    std::ofstream file(filename, std::ios::binary);
-    if (!file) {
+    return WriteFile(filename, data, WriteOptions());
+}
+
+bool WriteFile(const std::filesystem::path& filename, std::string_view data, const WriteOptions& options) {
+    if (options.atomic) {
+        return WriteFileAtomically(filename, data, options);
+    }
+    const int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (fd < 0) {
         return false;
     }
-    
-    file.write(data.data(), static_cast<std::streamsize>(data.size()));
-    return file.good();
+    return WriteAndClose(fd, data, options);
 }
 
 bool AppendToFile(const std::filesystem::path& filename, std::string_view data) {
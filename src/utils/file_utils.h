@@ -30,6 +30,30 @@ std::optional<std::string> ReadFile(const std::filesystem::path& filename);
  */
 bool WriteFile(const std::filesystem::path& filename, std::string_view data);
 
+/**
+ * @brief Durability settings for WriteFile.
+ */
+struct WriteOptions {
+    bool atomic = false;       // Replace the target through a temporary file and rename; never torn.
+    bool sync = false;         // fdatasync before returning; implied by atomic.
+    bool preallocate = false;  // Reserve the full size up front with fallocate.
+};
+
+/**
+ * @brief Writes data to a file, overwriting any existing content.
+ *
+ * In atomic mode the data goes to a temporary file in the same directory,
+ * which is synced, renamed over the target and made durable by syncing the
+ * directory; an existing target keeps its permissions. New files are
+ * created with 0666 less the umask in either mode.
+ *
+ * @param filename The path to the file.
+ * @param data The data to write.
+ * @param options Atomicity and durability settings.
+ * @return True if the operation was successful, false otherwise.
+ */
+bool WriteFile(const std::filesystem::path& filename, std::string_view data, const WriteOptions& options);
+
 /**
  * @brief Appends data to a file.
  * @param filename The path to the file.
@@ -40,6 +64,9 @@ bool AppendToFile(const std::filesystem::path& filename, std::string_view data);
 
 /**
  * @brief Reads a file line by line.
+ *
+ * Every line is copied into memory; use LineReader to stream large files.
+ *
  * @param filename The path to the file.
  * @return An optional containing the lines if successful, or std::nullopt otherwise.
  */
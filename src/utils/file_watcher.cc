@@ -0,0 +1,294 @@
+#include "src/utils/file_watcher.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+constexpr uint32_t kWatchMask =
+    IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF;
+
+// Large enough for many events per read; inotify records are 16 bytes plus the name.
+constexpr size_t kEventBufferSize = 64 << 10;
+
+std::optional<WatchEventType> TypeFromMask(uint32_t mask) {
+    if (mask & IN_Q_OVERFLOW) {
+        return WatchEventType::kOverflow;
+    }
+    if (mask & IN_CREATE) {
+        return WatchEventType::kCreated;
+    }
+    if (mask & IN_MODIFY) {
+        return WatchEventType::kModified;
+    }
+    if (mask & IN_CLOSE_WRITE) {
+        return WatchEventType::kClosedWrite;
+    }
+    if (mask & (IN_DELETE | IN_DELETE_SELF)) {
+        return WatchEventType::kDeleted;
+    }
+    if (mask & IN_MOVED_FROM) {
+        return WatchEventType::kMovedFrom;
+    }
+    if (mask & IN_MOVED_TO) {
+        return WatchEventType::kMovedTo;
+    }
+    return std::nullopt;
+}
+
+// Drops every modification of a path whose previous event in the batch
+// was also a modification, keeping the order of everything else.
+void MergeModifications(std::vector<WatchEvent>* batch) {
+    std::unordered_map<std::string, size_t> last;  // Path -> index of its latest kept event.
+    size_t kept = 0;
+    for (size_t i = 0; i < batch->size(); ++i) {
+        WatchEvent& event = (*batch)[i];
+        if (event.type == WatchEventType::kOverflow) {
+            // Events were lost, so what follows is not known to be consecutive.
+            last.clear();
+        } else {
+            auto [it, inserted] = last.try_emplace(event.path.native(), kept);
+            if (!inserted) {
+                if (event.type == WatchEventType::kModified &&
+                    (*batch)[it->second].type == WatchEventType::kModified) {
+                    continue;
+                }
+                it->second = kept;
+            }
+        }
+        if (kept != i) {
+            (*batch)[kept] = std::move(event);
+        }
+        ++kept;
+    }
+    batch->resize(kept);
+}
+
+// Waits until fd is readable; returns 1 when ready, 0 on timeout, -1 on error.
+int WaitReadable(int fd, int timeout_ms) {
+    pollfd pfd{fd, POLLIN, 0};
+    while (true) {
+        const int ready = ::poll(&pfd, 1, timeout_ms);
+        if (ready >= 0 || errno != EINTR) {
+            return ready;
+        }
+    }
+}
+
+}  // namespace
+
+std::unique_ptr<FileWatcher> FileWatcher::Create(WatchEventQueue* queue) {
+    const int inotify_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd < 0) {
+        return nullptr;
+    }
+    const int wake_fd = ::eventfd(0, EFD_CLOEXEC);
+    if (wake_fd < 0) {
+        ::close(inotify_fd);
+        return nullptr;
+    }
+    return std::unique_ptr<FileWatcher>(new FileWatcher(inotify_fd, wake_fd, queue));
+}
+
+FileWatcher::FileWatcher(int inotify_fd, int wake_fd, WatchEventQueue* queue)
+    : inotify_fd_(inotify_fd), wake_fd_(wake_fd), queue_(queue), thread_(&FileWatcher::Run, this) {}
+
+FileWatcher::~FileWatcher() {
+    const uint64_t one = 1;
+    ssize_t ignored = ::write(wake_fd_, &one, sizeof(one));
+    (void)ignored;
+    thread_.join();
+    ::close(wake_fd_);
+    ::close(inotify_fd_);
+}
+
+bool FileWatcher::AddWatch(const std::filesystem::path& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const int wd = ::inotify_add_watch(inotify_fd_, path.c_str(), kWatchMask);
+    if (wd < 0) {
+        return false;
+    }
+    paths_[wd] = path;
+    return true;
+}
+
+bool FileWatcher::RemoveWatch(const std::filesystem::path& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = paths_.begin(); it != paths_.end(); ++it) {
+        if (it->second == path) {
+            ::inotify_rm_watch(inotify_fd_, it->first);
+            paths_.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
+
+void FileWatcher::Run() {
+    std::unique_ptr<char[]> buffer(new char[kEventBufferSize]);
+    pollfd fds[2] = {{inotify_fd_, POLLIN, 0}, {wake_fd_, POLLIN, 0}};
+    while (true) {
+        if (::poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (fds[1].revents != 0) {
+            return;
+        }
+        // Drain everything queued so a burst becomes a single batch.
+        std::vector<WatchEvent> batch;
+        while (true) {
+            const ssize_t bytes = ::read(inotify_fd_, buffer.get(), kEventBufferSize);
+            if (bytes <= 0) {
+                break;
+            }
+            std::vector<WatchEvent> events = Decode(buffer.get(), static_cast<size_t>(bytes));
+            for (auto& event : events) {
+                batch.push_back(std::move(event));
+            }
+        }
+        MergeModifications(&batch);
+        if (!batch.empty()) {
+            queue_->Push(std::move(batch));
+        }
+    }
+}
+
+std::vector<WatchEvent> FileWatcher::Decode(const char* buffer, size_t size) {
+    std::vector<WatchEvent> events;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t offset = 0; offset < size;) {
+        inotify_event raw;
+        std::memcpy(&raw, buffer + offset, sizeof(raw));
+        const char* name = buffer + offset + sizeof(inotify_event);
+        offset += sizeof(inotify_event) + raw.len;
+
+        if (raw.mask & IN_IGNORED) {
+            // The watch is gone, e.g. because the watched path was deleted.
+            paths_.erase(raw.wd);
+            continue;
+        }
+        const std::optional<WatchEventType> type = TypeFromMask(raw.mask);
+        if (!type) {
+            continue;
+        }
+        WatchEvent event;
+        event.type = *type;
+        event.is_directory = (raw.mask & IN_ISDIR) != 0;
+        if (*type != WatchEventType::kOverflow) {
+            const auto it = paths_.find(raw.wd);
+            if (it == paths_.end()) {
+                continue;
+            }
+            // The name is NUL-padded, and absent for events on the watched path itself.
+            event.path = raw.len > 0 ? it->second / std::string(name) : it->second;
+        }
+        events.push_back(std::move(event));
+    }
+    return events;
+}
+
+std::unique_ptr<FileTailer> FileTailer::Open(const std::filesystem::path& filename, bool from_end) {
+    const int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+    const int inotify_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd < 0 || ::inotify_add_watch(inotify_fd, filename.c_str(), IN_MODIFY) < 0) {
+        if (inotify_fd >= 0) {
+            ::close(inotify_fd);
+        }
+        ::close(fd);
+        return nullptr;
+    }
+    uint64_t offset = 0;
+    if (from_end) {
+        struct stat st;
+        if (::fstat(fd, &st) == 0) {
+            offset = static_cast<uint64_t>(st.st_size);
+        }
+    }
+    return std::unique_ptr<FileTailer>(new FileTailer(fd, inotify_fd, offset));
+}
+
+FileTailer::FileTailer(int fd, int inotify_fd, uint64_t offset) : fd_(fd), inotify_fd_(inotify_fd), offset_(offset) {}
+
+FileTailer::~FileTailer() {
+    ::close(inotify_fd_);
+    ::close(fd_);
+}
+
+std::optional<size_t> FileTailer::Read(std::string* out, std::chrono::milliseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        const std::optional<size_t> bytes = ReadAvailable(out);
+        if (!bytes || *bytes > 0) {
+            return bytes;
+        }
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+            return 0;
+        }
+        const int ready = WaitReadable(inotify_fd_, static_cast<int>(remaining.count()));
+        if (ready < 0) {
+            return std::nullopt;
+        }
+        // Discard the notifications; the file itself says what is new.
+        char events[4096];
+        while (::read(inotify_fd_, events, sizeof(events)) > 0) {
+        }
+    }
+}
+
+std::optional<size_t> FileTailer::ReadAvailable(std::string* out) {
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+        return std::nullopt;
+    }
+    const auto size = static_cast<uint64_t>(st.st_size);
+    if (size < offset_) {
+        // Truncated: start over.
+        offset_ = 0;
+    }
+    if (size == offset_) {
+        return 0;
+    }
+    const size_t old_size = out->size();
+    out->resize(old_size + static_cast<size_t>(size - offset_));
+    size_t done = 0;
+    while (done < size - offset_) {
+        const ssize_t n = ::pread(fd_, out->data() + old_size + done, size - offset_ - done,
+                                  static_cast<off_t>(offset_ + done));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            out->resize(old_size);
+            return std::nullopt;
+        }
+        if (n == 0) {
+            break;
+        }
+        done += static_cast<size_t>(n);
+    }
+    out->resize(old_size + done);
+    offset_ += done;
+    return done;
+}
+
+}  // namespace utils
+}  // namespace cpp_utils
@@ -0,0 +1,158 @@
+/**
+ * @file file_watcher.h
+ * @brief Event-driven notification of file system changes.
+ */
+
+#ifndef CPP_UTILS_LIB_SRC_UTILS_FILE_WATCHER_H_
+#define CPP_UTILS_LIB_SRC_UTILS_FILE_WATCHER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "src/data_structures/thread_safe_queue.h"
+
+namespace cpp_utils {
+namespace utils {
+
+/**
+ * @brief What happened to a watched path.
+ */
+enum class WatchEventType {
+    kCreated,
+    kModified,     // Data was written; back-to-back writes to a path in one batch are merged.
+    kClosedWrite,  // A file opened for writing was closed; usually the moment it is complete.
+    kDeleted,
+    kMovedFrom,
+    kMovedTo,
+    kOverflow,     // The kernel dropped events; rescan whatever is being watched.
+};
+
+/**
+ * @brief One change reported by a FileWatcher.
+ */
+struct WatchEvent {
+    WatchEventType type;
+    std::filesystem::path path;  // Empty for kOverflow.
+    bool is_directory = false;
+};
+
+/**
+ * @brief Queue type that receives batches of events from a FileWatcher.
+ */
+using WatchEventQueue = data_structures::ThreadSafeQueue<std::vector<WatchEvent>>;
+
+/**
+ * @brief Watches files and directories with inotify and reports changes in batches.
+ *
+ * A background thread sleeps until the kernel reports changes, then pushes
+ * every event read in one go as a single batch onto the queue, so
+ * consumers wake once per burst rather than once per event. Within a
+ * batch, a kModified event is dropped if the previous event for the same
+ * path was also kModified, even when events for other paths came between
+ * them. Watching a directory reports changes to its direct children; it
+ * is not recursive.
+ */
+class FileWatcher {
+public:
+    /**
+     * @brief Starts a watcher that delivers into the given queue.
+     * @param queue Receives event batches; must outlive the watcher.
+     * @return The watcher, or nullptr if inotify is unavailable.
+     */
+    static std::unique_ptr<FileWatcher> Create(WatchEventQueue* queue);
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    ~FileWatcher();
+
+    /**
+     * @brief Starts watching a file or directory.
+     * @param path The path to watch; must exist.
+     * @return True if the watch was added, false otherwise.
+     */
+    bool AddWatch(const std::filesystem::path& path);
+
+    /**
+     * @brief Stops watching a path previously passed to AddWatch.
+     * @param path The watched path.
+     * @return True if the path was being watched, false otherwise.
+     */
+    bool RemoveWatch(const std::filesystem::path& path);
+
+private:
+    FileWatcher(int inotify_fd, int wake_fd, WatchEventQueue* queue);
+
+    // Body of the background thread.
+    void Run();
+
+    // Converts the raw events in buffer into WatchEvents.
+    std::vector<WatchEvent> Decode(const char* buffer, size_t size);
+
+    const int inotify_fd_;
+    const int wake_fd_;  // eventfd used to stop the background thread.
+    WatchEventQueue* const queue_;
+    std::unordered_map<int, std::filesystem::path> paths_;  // Watch descriptor to watched path.
+    std::mutex mutex_;
+    std::thread thread_;
+};
+
+/**
+ * @brief Follows a file as it grows, like `tail -f`.
+ *
+ * Reads block on inotify until the file is written, so new data is seen
+ * within milliseconds without polling. If the file is truncated (e.g. by
+ * copy-truncate log rotation) reading restarts from the beginning.
+ */
+class FileTailer {
+public:
+    /**
+     * @brief Opens a file for following.
+     * @param filename The path to the file.
+     * @param from_end Skip the existing contents and only report new data.
+     * @return The tailer, or nullptr if the file could not be opened.
+     */
+    static std::unique_ptr<FileTailer> Open(const std::filesystem::path& filename, bool from_end = false);
+
+    FileTailer(const FileTailer&) = delete;
+    FileTailer& operator=(const FileTailer&) = delete;
+
+    ~FileTailer();
+
+    /**
+     * @brief Appends newly written data to out, waiting for it if there is none.
+     * @param out Receives the new bytes; existing contents are kept.
+     * @param timeout How long to wait for data.
+     * @return The number of bytes appended (0 on timeout), or std::nullopt on error.
+     */
+    std::optional<size_t> Read(std::string* out, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Gets the offset of the next byte to be read.
+     * @return The file offset.
+     */
+    uint64_t Offset() const { return offset_; }
+
+private:
+    FileTailer(int fd, int inotify_fd, uint64_t offset);
+
+    // Reads whatever is available without blocking.
+    std::optional<size_t> ReadAvailable(std::string* out);
+
+    const int fd_;
+    const int inotify_fd_;
+    uint64_t offset_;
+};
+
+}  // namespace utils
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_SRC_UTILS_FILE_WATCHER_H_
@@ -0,0 +1,140 @@
+#include "src/utils/line_reader.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+namespace cpp_utils {
+namespace utils {
+
+std::optional<LineReader> LineReader::Open(const std::filesystem::path& filename, size_t buffer_size) {
+    const int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return std::nullopt;
+    }
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    LineReader reader(
+        [fd](char* buffer, size_t capacity) -> std::optional<size_t> {
+            while (true) {
+                const ssize_t n = ::read(fd, buffer, capacity);
+                if (n >= 0) {
+                    return static_cast<size_t>(n);
+                }
+                if (errno != EINTR) {
+                    return std::nullopt;
+                }
+            }
+        },
+        buffer_size);
+    reader.fd_ = fd;
+    return reader;
+}
+
+LineReader::LineReader(ReadFunction read, size_t buffer_size)
+    : read_(std::move(read)),
+      storage_(new char[buffer_size > 0 ? buffer_size : 1]),
+      capacity_(buffer_size > 0 ? buffer_size : 1),
+      data_(storage_.get()) {}
+
+LineReader::LineReader(std::string_view data) : data_(data.data()), end_(data.size()), eof_(true) {}
+
+LineReader::LineReader(LineReader&& other) noexcept {
+    *this = std::move(other);
+}
+
+LineReader& LineReader::operator=(LineReader&& other) noexcept {
+    if (this != &other) {
+        Close();
+        read_ = std::move(other.read_);
+        fd_ = std::exchange(other.fd_, -1);
+        storage_ = std::move(other.storage_);
+        capacity_ = other.capacity_;
+        data_ = other.data_;
+        begin_ = other.begin_;
+        scan_ = other.scan_;
+        end_ = other.end_;
+        eof_ = other.eof_;
+        error_ = other.error_;
+        line_count_ = other.line_count_;
+        other.data_ = nullptr;
+        other.begin_ = other.scan_ = other.end_ = 0;
+        other.eof_ = true;
+    }
+    return *this;
+}
+
+LineReader::~LineReader() {
+    Close();
+}
+
+void LineReader::Close() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool LineReader::Next(std::string_view* line) {
+    while (true) {
+        const char* newline = scan_ < end_
+            ? static_cast<const char*>(std::memchr(data_ + scan_, '\n', end_ - scan_))
+            : nullptr;
+        size_t line_end;
+        if (newline != nullptr) {
+            line_end = static_cast<size_t>(newline - data_);
+        } else if (eof_) {
+            if (begin_ == end_) {
+                return false;
+            }
+            line_end = end_;
+        } else {
+            scan_ = end_;
+            Refill();
+            continue;
+        }
+
+        size_t length = line_end - begin_;
+        if (length > 0 && data_[begin_ + length - 1] == '\r') {
+            --length;
+        }
+        *line = std::string_view(data_ + begin_, length);
+        begin_ = scan_ = std::min(line_end + 1, end_);
+        ++line_count_;
+        return true;
+    }
+}
+
+void LineReader::Refill() {
+    const size_t pending = end_ - begin_;
+    if (begin_ > 0) {
+        std::memmove(storage_.get(), storage_.get() + begin_, pending);
+    } else if (pending == capacity_) {
+        // One line fills the whole buffer: double it.
+        std::unique_ptr<char[]> grown(new char[capacity_ * 2]);
+        std::memcpy(grown.get(), storage_.get(), pending);
+        storage_ = std::move(grown);
+        capacity_ *= 2;
+    }
+    data_ = storage_.get();
+    scan_ -= begin_;
+    begin_ = 0;
+    end_ = pending;
+
+    const std::optional<size_t> n = read_(storage_.get() + end_, capacity_ - end_);
+    if (!n) {
+        error_ = true;
+        eof_ = true;
+    } else if (*n == 0) {
+        eof_ = true;
+    } else {
+        end_ += *n;
+    }
+}
+
+}  // namespace utils
+}  // namespace cpp_utils
@@ -0,0 +1,114 @@
+/**
+ * @file line_reader.h
+ * @brief Streaming, zero-copy iteration over the lines of a file.
+ */
+
+#ifndef CPP_UTILS_LIB_SRC_UTILS_LINE_READER_H_
+#define CPP_UTILS_LIB_SRC_UTILS_LINE_READER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+namespace cpp_utils {
+namespace utils {
+
+/**
+ * @brief Reads lines one at a time as views into a reusable buffer.
+ *
+ * Memory use is bounded by the buffer size (or the longest line, if that is
+ * larger) no matter how big the input is. Newlines are found with memchr,
+ * and a trailing '\r' is stripped so CRLF files yield the same lines as LF
+ * files. Like ReadLines(), a final newline does not produce an empty line.
+ *
+ * Each view returned by Next() is only valid until the following call.
+ */
+class LineReader {
+public:
+    /**
+     * @brief Fills a buffer with the next bytes of input.
+     *
+     * Returns the number of bytes written (0 at end of input), or
+     * std::nullopt on a read error.
+     */
+    using ReadFunction = std::function<std::optional<size_t>(char* buffer, size_t capacity)>;
+
+    static constexpr size_t kDefaultBufferSize = 1 << 20;
+
+    /**
+     * @brief Opens a file for line-by-line reading.
+     * @param filename The path to the file.
+     * @param buffer_size The initial buffer size.
+     * @return An optional containing the reader if the file could be opened, or std::nullopt otherwise.
+     */
+    static std::optional<LineReader> Open(const std::filesystem::path& filename,
+                                          size_t buffer_size = kDefaultBufferSize);
+
+    /**
+     * @brief Reads lines from an arbitrary byte source, e.g. a decompressor.
+     * @param read The function that supplies input bytes.
+     * @param buffer_size The initial buffer size.
+     */
+    explicit LineReader(ReadFunction read, size_t buffer_size = kDefaultBufferSize);
+
+    /**
+     * @brief Reads lines from memory that is already loaded, e.g. a MappedFile.
+     * @param data The bytes to read; must outlive the reader. Nothing is copied.
+     */
+    explicit LineReader(std::string_view data);
+
+    LineReader(const LineReader&) = delete;
+    LineReader& operator=(const LineReader&) = delete;
+
+    LineReader(LineReader&& other) noexcept;
+    LineReader& operator=(LineReader&& other) noexcept;
+
+    ~LineReader();
+
+    /**
+     * @brief Advances to the next line.
+     * @param line Receives the line, without its terminator.
+     * @return True if a line was read, false at end of input or on error.
+     */
+    bool Next(std::string_view* line);
+
+    /**
+     * @brief Checks whether reading stopped because of an I/O error.
+     * @return True if the byte source reported an error.
+     */
+    bool HasError() const { return error_; }
+
+    /**
+     * @brief Gets the number of lines returned so far.
+     * @return The line count.
+     */
+    uint64_t LineCount() const { return line_count_; }
+
+private:
+    // Moves the unconsumed tail to the front, grows the buffer if a single
+    // line fills it, and reads more input after the tail.
+    void Refill();
+
+    void Close();
+
+    ReadFunction read_;
+    int fd_ = -1;  // Owned file descriptor when opened from a path.
+    std::unique_ptr<char[]> storage_;
+    size_t capacity_ = 0;
+    const char* data_ = nullptr;  // storage_.get(), or caller memory.
+    size_t begin_ = 0;            // Start of the unconsumed bytes.
+    size_t scan_ = 0;             // Bytes before this offset hold no newline.
+    size_t end_ = 0;              // End of the valid bytes.
+    bool eof_ = false;
+    bool error_ = false;
+    uint64_t line_count_ = 0;
+};
+
+}  // namespace utils
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_SRC_UTILS_LINE_READER_H_
@@ -0,0 +1,404 @@
+#include "src/utils/log_store.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <system_error>
+#include <vector>
+
+#include "src/utils/mapped_file.h"
+#include "src/utils/varint.h"
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+// Record layout: fixed32 checksum of everything after it, varint key size,
+// varint (value size << 1 | live), key bytes, value bytes. Erased keys are
+// recorded as a non-live record with an empty value.
+constexpr size_t kChecksumSize = 4;
+constexpr size_t kMaxRecordSize = size_t{1} << 31;
+
+// FNV-1a, continued from a previous state so a record can be hashed in parts.
+uint32_t Checksum(std::string_view data, uint32_t state = 2166136261u) {
+    for (char c : data) {
+        state = (state ^ static_cast<unsigned char>(c)) * 16777619u;
+    }
+    return state;
+}
+
+constexpr std::string_view kSegmentPrefix = "segment-";
+constexpr std::string_view kSegmentSuffix = ".log";
+
+// Ids are zero-padded to six digits but may grow longer.
+bool ParseSegmentId(std::string_view name, uint32_t* id) {
+    if (name.size() <= kSegmentPrefix.size() + kSegmentSuffix.size() ||
+        name.substr(0, kSegmentPrefix.size()) != kSegmentPrefix ||
+        name.substr(name.size() - kSegmentSuffix.size()) != kSegmentSuffix) {
+        return false;
+    }
+    const std::string_view digits =
+        name.substr(kSegmentPrefix.size(), name.size() - kSegmentPrefix.size() - kSegmentSuffix.size());
+    const auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), *id);
+    return error == std::errc() && end == digits.data() + digits.size();
+}
+
+bool ReadFully(int fd, char* data, size_t size, uint64_t offset) {
+    while (size > 0) {
+        const ssize_t n = ::pread(fd, data, size, static_cast<off_t>(offset));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+        offset += static_cast<uint64_t>(n);
+    }
+    return true;
+}
+
+}  // namespace
+
+std::unique_ptr<LogStore> LogStore::Open(const std::filesystem::path& directory,
+                                         const LogStoreOptions& options) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        return nullptr;
+    }
+    std::unique_ptr<LogStore> store(new LogStore(directory, options));
+    std::lock_guard<std::mutex> lock(store->mutex_);
+    if (!store->Recover()) {
+        return nullptr;
+    }
+    return store;
+}
+
+LogStore::LogStore(const std::filesystem::path& directory, const LogStoreOptions& options)
+    : directory_(directory), options_(options) {}
+
+LogStore::~LogStore() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    writer_.reset();
+    for (auto& [id, segment] : segments_) {
+        ::close(segment.fd);
+    }
+}
+
+std::filesystem::path LogStore::SegmentPath(uint32_t id) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "segment-%06u.log", id);
+    return directory_ / name;
+}
+
+bool LogStore::Recover() {
+    std::vector<uint32_t> ids;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory_, error)) {
+        uint32_t id;
+        if (entry.is_regular_file(error) && ParseSegmentId(entry.path().filename().string(), &id)) {
+            ids.push_back(id);
+        }
+    }
+    if (error) {
+        return false;
+    }
+    // The index must see the segments in the order they were written.
+    std::sort(ids.begin(), ids.end());
+    for (uint32_t id : ids) {
+        if (!RecoverSegment(id)) {
+            return false;
+        }
+    }
+
+    // Keep appending to the last segment unless it is already full.
+    if (!ids.empty() && segments_[ids.back()].size < options_.segment_bytes) {
+        return StartSegment(ids.back());
+    }
+    return StartSegment(ids.empty() ? 0 : ids.back() + 1);
+}
+
+bool LogStore::RecoverSegment(uint32_t id) {
+    const std::filesystem::path path = SegmentPath(id);
+    auto file = MappedFile::Open(path);
+    if (!file) {
+        return false;
+    }
+    const std::string_view data = file->View();
+    Segment segment;
+
+    size_t pos = 0;
+    while (pos < data.size()) {
+        if (data.size() - pos < kChecksumSize) {
+            break;
+        }
+        uint32_t expected;
+        std::memcpy(&expected, data.data() + pos, kChecksumSize);
+        std::string_view rest = data.substr(pos + kChecksumSize);
+        uint64_t key_size = 0;
+        uint64_t tag = 0;
+        if (!GetVarint64(&rest, &key_size) || !GetVarint64(&rest, &tag) ||
+            key_size > rest.size() || (tag >> 1) > rest.size() - key_size) {
+            break;
+        }
+        const size_t value_size = static_cast<size_t>(tag >> 1);
+        const size_t header_size = static_cast<size_t>(rest.data() - data.data()) - pos;
+        const size_t record_size = header_size + static_cast<size_t>(key_size) + value_size;
+        if (Checksum(data.substr(pos + kChecksumSize, record_size - kChecksumSize)) != expected) {
+            break;
+        }
+
+        const std::string key(rest.data(), static_cast<size_t>(key_size));
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            (it->second.segment == id ? segment.garbage : segments_[it->second.segment].garbage) +=
+                it->second.record_size;
+        }
+        if (tag & 1) {
+            const Location location{id, pos + header_size + key_size, static_cast<uint32_t>(value_size),
+                                    static_cast<uint32_t>(record_size)};
+            index_.insert_or_assign(key, location);
+        } else {
+            segment.garbage += record_size;
+            if (it != index_.end()) {
+                index_.erase(it);
+            }
+        }
+        pos += record_size;
+    }
+
+    // Whatever follows the last intact record is a torn write; cut it off.
+    if (pos < data.size() && ::truncate(path.c_str(), static_cast<off_t>(pos)) != 0) {
+        return false;
+    }
+    segment.size = pos;
+    segment.fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (segment.fd < 0) {
+        return false;
+    }
+    segments_[id] = segment;
+    return true;
+}
+
+bool LogStore::StartSegment(uint32_t id) {
+    // Destroying the old writer flushes the sealed segment.
+    writer_.reset();
+    unflushed_ = false;
+
+    AppendOptions append_options;
+    append_options.buffer_size = options_.buffer_size;
+    writer_ = AppendWriter::Open(SegmentPath(id), append_options);
+    if (!writer_) {
+        return false;
+    }
+    if (segments_.find(id) == segments_.end()) {
+        Segment segment;
+        segment.fd = ::open(SegmentPath(id).c_str(), O_RDONLY | O_CLOEXEC);
+        if (segment.fd < 0) {
+            writer_.reset();
+            return false;
+        }
+        segments_[id] = segment;
+    }
+    active_ = id;
+    return true;
+}
+
+bool LogStore::AppendLocked(std::string_view key, std::string_view value, bool live, Location* location) {
+    if (!writer_ || key.size() + value.size() > kMaxRecordSize) {
+        return false;
+    }
+    if (segments_[active_].size >= options_.segment_bytes) {
+        if (!StartSegment(active_ + 1)) {
+            return false;
+        }
+        if (!compacting_ && options_.compaction_ratio > 0) {
+            uint64_t sealed = 0;
+            uint64_t garbage = 0;
+            for (const auto& [id, segment] : segments_) {
+                if (id != active_) {
+                    sealed += segment.size;
+                    garbage += segment.garbage;
+                }
+            }
+            if (garbage > 0 && static_cast<double>(garbage) >= options_.compaction_ratio * sealed &&
+                !CompactLocked()) {
+                return false;
+            }
+        }
+    }
+
+    std::string header(kChecksumSize, '\0');
+    PutVarint64(&header, key.size());
+    PutVarint64(&header, (uint64_t{value.size()} << 1) | (live ? 1 : 0));
+    const uint32_t checksum =
+        Checksum(value, Checksum(key, Checksum(std::string_view(header).substr(kChecksumSize))));
+    std::memcpy(header.data(), &checksum, kChecksumSize);
+    const size_t header_size = header.size();
+
+    if (!writer_->Append({header, key, value})) {
+        return false;
+    }
+    Segment& segment = segments_[active_];
+    const size_t record_size = header_size + key.size() + value.size();
+    *location = Location{active_, segment.size + header_size + key.size(), static_cast<uint32_t>(value.size()),
+                         static_cast<uint32_t>(record_size)};
+    segment.size += record_size;
+    unflushed_ = true;
+    return true;
+}
+
+bool LogStore::ReadLocked(const Location& location, std::string* value) {
+    if (location.segment == active_ && unflushed_) {
+        if (!writer_->Flush()) {
+            return false;
+        }
+        unflushed_ = false;
+    }
+    value->resize(location.value_size);
+    return ReadFully(segments_[location.segment].fd, value->data(), value->size(), location.offset);
+}
+
+bool LogStore::Put(std::string_view key, std::string_view value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Location location;
+    if (!AppendLocked(key, value, true, &location)) {
+        return false;
+    }
+    auto [it, inserted] = index_.try_emplace(std::string(key), location);
+    if (!inserted) {
+        segments_[it->second.segment].garbage += it->second.record_size;
+        it->second = location;
+    }
+    return true;
+}
+
+std::optional<std::string> LogStore::Get(std::string_view key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(std::string(key));
+    if (it == index_.end()) {
+        return std::nullopt;
+    }
+    std::string value;
+    if (!ReadLocked(it->second, &value)) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+bool LogStore::Erase(std::string_view key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(std::string(key));
+    if (it == index_.end()) {
+        return false;
+    }
+    Location tombstone;
+    if (!AppendLocked(key, std::string_view(), false, &tombstone)) {
+        return false;
+    }
+    // The append may have compacted and moved the entry; look it up again.
+    it = index_.find(std::string(key));
+    segments_[it->second.segment].garbage += it->second.record_size;
+    segments_[tombstone.segment].garbage += tombstone.record_size;
+    index_.erase(it);
+    return true;
+}
+
+bool LogStore::Contains(std::string_view key) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_.find(std::string(key)) != index_.end();
+}
+
+size_t LogStore::Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_.size();
+}
+
+bool LogStore::Compact() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Seal the active segment too if it holds anything to reclaim.
+    if (segments_[active_].garbage > 0 && !StartSegment(active_ + 1)) {
+        return false;
+    }
+    return CompactLocked();
+}
+
+bool LogStore::CompactLocked() {
+    // Everything before the current active segment is sealed. Copies land in
+    // the active segment or in segments started while copying, all of which
+    // have higher ids and survive.
+    const uint32_t first_kept = active_;
+    if (segments_.begin()->first == first_kept) {
+        return true;
+    }
+    compacting_ = true;
+    std::string value;
+    bool ok = true;
+    for (auto& [key, location] : index_) {
+        if (location.segment >= first_kept) {
+            continue;
+        }
+        Location moved;
+        if (!ReadLocked(location, &value) || !AppendLocked(key, value, true, &moved)) {
+            ok = false;
+            break;
+        }
+        location = moved;
+    }
+    compacting_ = false;
+    // The copies must be durable before the originals go away.
+    if (!ok || !writer_->Sync()) {
+        return false;
+    }
+    unflushed_ = false;
+
+    for (auto it = segments_.begin(); it != segments_.end() && it->first < first_kept;) {
+        ::close(it->second.fd);
+        std::error_code error;
+        std::filesystem::remove(SegmentPath(it->first), error);
+        it = segments_.erase(it);
+    }
+    return true;
+}
+
+bool LogStore::Flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!writer_ || !writer_->Flush()) {
+        return false;
+    }
+    unflushed_ = false;
+    return true;
+}
+
+bool LogStore::Sync() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!writer_ || !writer_->Sync()) {
+        return false;
+    }
+    unflushed_ = false;
+    return true;
+}
+
+uint64_t LogStore::DiskBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t total = 0;
+    for (const auto& [id, segment] : segments_) {
+        total += segment.size;
+    }
+    return total;
+}
+
+size_t LogStore::SegmentCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return segments_.size();
+}
+
+}  // namespace utils
+}  // namespace cpp_utils
@@ -0,0 +1,173 @@
+/**
+ * @file log_store.h
+ * @brief A key-value store kept in append-only segment files.
+ */
+
+#ifndef CPP_UTILS_LIB_SRC_UTILS_LOG_STORE_H_
+#define CPP_UTILS_LIB_SRC_UTILS_LOG_STORE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "src/utils/append_writer.h"
+
+namespace cpp_utils {
+namespace utils {
+
+/**
+ * @brief Segment sizing and compaction settings for a LogStore.
+ */
+struct LogStoreOptions {
+    uint64_t segment_bytes = 64 << 20;  // Start a new segment once the active one reaches this size.
+    double compaction_ratio = 0.5;      // Compact when this fraction of the sealed bytes is garbage; 0 disables.
+    size_t buffer_size = 1 << 20;       // Write buffer of the active segment.
+};
+
+/**
+ * @brief A persistent key-value store built from append-only log segments.
+ *
+ * Every Put() and Erase() appends a record to the active segment file, and
+ * an in-memory index maps each live key to the location of its latest
+ * value, so a lookup costs one pread. Once the active segment reaches
+ * segment_bytes it is sealed and a new one is started. Overwritten and
+ * erased records become garbage; when enough of the sealed segments is
+ * garbage, the live records are copied forward and the old segments are
+ * deleted.
+ *
+ * Open() rebuilds the index by scanning the segments. Each record carries a
+ * checksum, and a torn record at the end of a segment (from a crash during
+ * a write) is cut off. Records reach the kernel on Flush(), when the write
+ * buffer fills, or when the store is destroyed; Sync() also waits for the
+ * disk.
+ *
+ * All methods are thread-safe.
+ */
+class LogStore {
+public:
+    /**
+     * @brief Opens the store in a directory, creating it if necessary.
+     * @param directory The directory holding the segment files.
+     * @param options Segment sizing and compaction settings.
+     * @return The store, or nullptr if the directory or a segment could not be opened.
+     */
+    static std::unique_ptr<LogStore> Open(const std::filesystem::path& directory,
+                                          const LogStoreOptions& options = LogStoreOptions());
+
+    LogStore(const LogStore&) = delete;
+    LogStore& operator=(const LogStore&) = delete;
+
+    ~LogStore();
+
+    /**
+     * @brief Stores a value, replacing any previous one.
+     * @param key The key.
+     * @param value The value.
+     * @return True on success, false if the write failed.
+     */
+    bool Put(std::string_view key, std::string_view value);
+
+    /**
+     * @brief Reads the latest value of a key.
+     * @param key The key to look up.
+     * @return The value, or std::nullopt if the key is absent or the read failed.
+     */
+    std::optional<std::string> Get(std::string_view key);
+
+    /**
+     * @brief Removes a key by appending a tombstone.
+     * @param key The key to remove.
+     * @return True if the key was present and the tombstone was written.
+     */
+    bool Erase(std::string_view key);
+
+    /**
+     * @brief Checks whether a key is present.
+     * @param key The key to check.
+     * @return True if the key has a live value.
+     */
+    bool Contains(std::string_view key) const;
+
+    /**
+     * @brief Gets the number of live keys.
+     * @return The number of keys.
+     */
+    size_t Size() const;
+
+    /**
+     * @brief Copies the live records of all sealed segments forward and deletes those segments.
+     * @return True on success.
+     */
+    bool Compact();
+
+    /**
+     * @brief Hands buffered records to the kernel.
+     * @return True on success.
+     */
+    bool Flush();
+
+    /**
+     * @brief Flushes, then waits until the records are on stable storage.
+     * @return True on success.
+     */
+    bool Sync();
+
+    /**
+     * @brief Gets the size of all segment files, live records and garbage alike.
+     * @return The number of bytes on disk.
+     */
+    uint64_t DiskBytes() const;
+
+    /**
+     * @brief Gets the number of segment files.
+     * @return The number of segments, including the active one.
+     */
+    size_t SegmentCount() const;
+
+private:
+    struct Location {
+        uint32_t segment;
+        uint64_t offset;       // Where the value starts in the segment file.
+        uint32_t value_size;
+        uint32_t record_size;  // Counted as garbage once the value is replaced.
+    };
+
+    struct Segment {
+        int fd = -1;           // Opened for reading.
+        uint64_t size = 0;
+        uint64_t garbage = 0;  // Bytes of records that are no longer live.
+    };
+
+    LogStore(const std::filesystem::path& directory, const LogStoreOptions& options);
+
+    std::filesystem::path SegmentPath(uint32_t id) const;
+    bool Recover();
+    bool RecoverSegment(uint32_t id);
+    bool StartSegment(uint32_t id);
+    bool AppendLocked(std::string_view key, std::string_view value, bool live, Location* location);
+    bool ReadLocked(const Location& location, std::string* value);
+    bool CompactLocked();
+
+    const std::filesystem::path directory_;
+    const LogStoreOptions options_;
+
+    mutable std::mutex mutex_;
+    std::map<uint32_t, Segment> segments_;
+    std::unordered_map<std::string, Location> index_;
+    std::unique_ptr<AppendWriter> writer_;  // Appends to the last segment.
+    uint32_t active_ = 0;
+    bool unflushed_ = false;  // The active segment has records the kernel has not seen.
+    bool compacting_ = false;
+};
+
+}  // namespace utils
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_SRC_UTILS_LOG_STORE_H_
@@ -0,0 +1,83 @@
+#include "src/utils/mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace cpp_utils {
+namespace utils {
+
+std::optional<MappedFile> MappedFile::Open(const std::filesystem::path& filename, const MapOptions& options) {
+    const int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return std::nullopt;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return std::nullopt;
+    }
+    const auto size = static_cast<size_t>(st.st_size);
+    if (size == 0) {
+        // mmap rejects zero-length mappings; an empty view needs none.
+        ::close(fd);
+        return MappedFile(nullptr, 0);
+    }
+
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file.
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return std::nullopt;
+    }
+
+    // Hints are best effort; a kernel that rejects one still serves the mapping.
+    if (options.random) {
+        ::madvise(data, size, MADV_RANDOM);
+    } else if (options.sequential) {
+        ::madvise(data, size, MADV_SEQUENTIAL);
+    }
+    if (options.will_need) {
+        ::madvise(data, size, MADV_WILLNEED);
+    }
+#ifdef MADV_HUGEPAGE
+    if (options.huge_pages) {
+        ::madvise(data, size, MADV_HUGEPAGE);
+    }
+#endif
+
+    return MappedFile(static_cast<const char*>(data), size);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept : data_(other.data_), size_(other.size_) {
+    other.data_ = nullptr;
+    other.size_ = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Unmap();
+        data_ = other.data_;
+        size_ = other.size_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    Unmap();
+}
+
+void MappedFile::Unmap() {
+    if (data_ != nullptr) {
+        ::munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+}  // namespace utils
+}  // namespace cpp_utils
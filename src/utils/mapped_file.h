@@ -0,0 +1,84 @@
+/**
+ * @file mapped_file.h
+ * @brief Read-only memory-mapped file access.
+ */
+
+#ifndef CPP_UTILS_LIB_SRC_UTILS_MAPPED_FILE_H_
+#define CPP_UTILS_LIB_SRC_UTILS_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+namespace cpp_utils {
+namespace utils {
+
+/**
+ * @brief Access-pattern hints passed to madvise after mapping.
+ */
+struct MapOptions {
+    bool sequential = true;   // Read mostly front to back (MADV_SEQUENTIAL); aggressive readahead.
+    bool random = false;      // Read in random order (MADV_RANDOM); overrides sequential.
+    bool will_need = false;   // Start reading the whole file in now (MADV_WILLNEED).
+    bool huge_pages = false;  // Back the mapping with huge pages where supported (MADV_HUGEPAGE).
+};
+
+/**
+ * @brief A read-only memory mapping of a whole file.
+ *
+ * The contents are exposed as a std::string_view without copying them into
+ * the process heap; pages are loaded on first access and can be dropped by
+ * the kernel under memory pressure. The view stays valid as long as the
+ * MappedFile is alive. Move-only.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Maps a file into memory.
+     * @param filename The path to the file.
+     * @param options Access-pattern hints.
+     * @return An optional containing the mapping if successful, or std::nullopt otherwise.
+     */
+    static std::optional<MappedFile> Open(const std::filesystem::path& filename,
+                                          const MapOptions& options = MapOptions());
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    ~MappedFile();
+
+    /**
+     * @brief Gets the file contents.
+     * @return A view of the mapped bytes; empty for an empty file.
+     */
+    std::string_view View() const { return std::string_view(data_, size_); }
+
+    /**
+     * @brief Gets a pointer to the first mapped byte.
+     * @return The mapped bytes, or nullptr for an empty file.
+     */
+    const char* Data() const { return data_; }
+
+    /**
+     * @brief Gets the size of the mapping.
+     * @return The file size in bytes at the time it was mapped.
+     */
+    size_t Size() const { return size_; }
+
+private:
+    MappedFile(const char* data, size_t size) : data_(data), size_(size) {}
+
+    void Unmap();
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+}  // namespace utils
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_SRC_UTILS_MAPPED_FILE_H_
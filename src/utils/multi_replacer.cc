@@ -0,0 +1,117 @@
+#include "src/utils/multi_replacer.h"
+
+#include <queue>
+
+namespace cpp_utils {
+namespace utils {
+
+MultiReplacer::MultiReplacer(const std::vector<std::pair<std::string, std::string>>& replacements) {
+    // Build the trie; missing transitions stay -1 until the failure pass.
+    next_.assign(kAlphabet, -1);
+    depth_.push_back(0);
+    match_.push_back(-1);
+    for (const auto& [pattern, replacement] : replacements) {
+        if (pattern.empty()) {
+            continue;
+        }
+        int32_t state = 0;
+        for (char c : pattern) {
+            const size_t slot = static_cast<size_t>(state) * kAlphabet + static_cast<unsigned char>(c);
+            if (next_[slot] < 0) {
+                next_[slot] = static_cast<int32_t>(depth_.size());
+                depth_.push_back(depth_[state] + 1);
+                match_.push_back(-1);
+                next_.resize(next_.size() + kAlphabet, -1);
+            }
+            state = next_[slot];
+        }
+        if (match_[state] < 0) {
+            match_[state] = static_cast<int32_t>(replacements_.size());
+            pattern_sizes_.push_back(pattern.size());
+            replacements_.push_back(replacement);
+        }
+    }
+
+    // Breadth-first, resolve failure links into a complete transition table.
+    // A state's failure target is shallower, so it is always finished first.
+    std::vector<int32_t> fail(depth_.size(), 0);
+    std::queue<int32_t> pending;
+    for (size_t c = 0; c < kAlphabet; ++c) {
+        int32_t& child = next_[c];
+        if (child < 0) {
+            child = 0;
+        } else {
+            pending.push(child);
+        }
+    }
+    while (!pending.empty()) {
+        const int32_t state = pending.front();
+        pending.pop();
+        // Patterns ending at the failure state end here too; they are shorter
+        // than this state's own pattern, so only fill in when it has none.
+        if (match_[state] < 0) {
+            match_[state] = match_[fail[state]];
+        }
+        const size_t base = static_cast<size_t>(state) * kAlphabet;
+        const size_t fail_base = static_cast<size_t>(fail[state]) * kAlphabet;
+        for (size_t c = 0; c < kAlphabet; ++c) {
+            int32_t& child = next_[base + c];
+            if (child < 0) {
+                child = next_[fail_base + c];
+            } else {
+                fail[child] = next_[fail_base + c];
+                pending.push(child);
+            }
+        }
+    }
+}
+
+std::string MultiReplacer::Apply(std::string_view input) const {
+    std::string out;
+    Apply(input, &out);
+    return out;
+}
+
+void MultiReplacer::Apply(std::string_view input, std::string* out) const {
+    out->clear();
+    out->reserve(input.size());
+
+    constexpr size_t kNone = std::string_view::npos;
+    size_t emitted = 0;  // Input before this offset has been written to out.
+    size_t best_start = kNone;
+    int32_t best = -1;
+
+    int32_t state = 0;
+    size_t pos = 0;
+    while (pos < input.size() || best >= 0) {
+        if (pos < input.size()) {
+            state = Next(state, input[pos]);
+            ++pos;
+
+            const int32_t found = match_[state];
+            if (found >= 0) {
+                const size_t start = pos - pattern_sizes_[found];
+                if (best < 0 || start < best_start ||
+                    (start == best_start && pattern_sizes_[found] > pattern_sizes_[best])) {
+                    best = found;
+                    best_start = start;
+                }
+            }
+        }
+
+        // Commit once no partial match can still start at or before the best
+        // one, or when the input runs out; then rescan from just after it.
+        if (best >= 0 && (pos == input.size() || pos - static_cast<size_t>(depth_[state]) > best_start)) {
+            out->append(input, emitted, best_start - emitted);
+            out->append(replacements_[best]);
+            emitted = best_start + pattern_sizes_[best];
+            pos = emitted;
+            state = 0;
+            best = -1;
+        }
+    }
+    out->append(input, emitted, kNone);
+}
+
+}  // namespace utils
+}  // namespace cpp_utils
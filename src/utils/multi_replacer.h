@@ -0,0 +1,79 @@
+/**
+ * @file multi_replacer.h
+ * @brief Replaces many patterns in one pass using a precompiled automaton.
+ */
+
+#ifndef CPP_UTILS_LIB_SRC_UTILS_MULTI_REPLACER_H_
+#define CPP_UTILS_LIB_SRC_UTILS_MULTI_REPLACER_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace cpp_utils {
+namespace utils {
+
+/**
+ * @brief Replaces any of a fixed set of patterns in a single pass.
+ *
+ * The patterns are compiled once into an Aho-Corasick automaton, so the
+ * cost of applying the replacer does not grow with the number of patterns.
+ * Matches are non-overlapping and chosen leftmost first; among patterns
+ * starting at the same position the longest wins. After each replacement
+ * the scan restarts just past the match and rereads any input the
+ * automaton had already looked ahead at, so the worst case is
+ * O(n * longest pattern), e.g. for "a" and "aaa...ab" over a run of 'a's;
+ * typical inputs are scanned close to once. Instances are immutable after
+ * construction and may be shared between threads.
+ */
+class MultiReplacer {
+public:
+    /**
+     * @brief Compiles a set of replacements.
+     *
+     * Empty patterns are ignored; for duplicate patterns the first one wins.
+     *
+     * @param replacements Pairs of (pattern, replacement).
+     */
+    explicit MultiReplacer(const std::vector<std::pair<std::string, std::string>>& replacements);
+
+    /**
+     * @brief Replaces every match in the input.
+     * @param input The text to process.
+     * @return The text with all matches replaced.
+     */
+    std::string Apply(std::string_view input) const;
+
+    /**
+     * @brief Replaces every match in the input, writing into a reusable buffer.
+     * @param input The text to process.
+     * @param out Receives the result; its previous contents are discarded.
+     */
+    void Apply(std::string_view input, std::string* out) const;
+
+    /**
+     * @brief Gets the number of distinct, non-empty patterns.
+     * @return The number of patterns.
+     */
+    size_t PatternCount() const { return replacements_.size(); }
+
+private:
+    static constexpr size_t kAlphabet = 256;
+
+    int32_t Next(int32_t state, char c) const {
+        return next_[static_cast<size_t>(state) * kAlphabet + static_cast<unsigned char>(c)];
+    }
+
+    std::vector<int32_t> next_;        // Full transition table, kAlphabet entries per state.
+    std::vector<int32_t> depth_;       // Length of the prefix each state represents.
+    std::vector<int32_t> match_;       // Longest pattern ending at each state, or -1.
+    std::vector<size_t> pattern_sizes_;
+    std::vector<std::string> replacements_;
+};
+
+}  // namespace utils
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_SRC_UTILS_MULTI_REPLACER_H_
@@ -0,0 +1,95 @@
+#include "src/utils/parallel_file.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+#include "src/utils/mapped_file.h"
+
+namespace cpp_utils {
+namespace utils {
+
+size_t ResolveThreadCount(size_t threads) {
+    if (threads > 0) {
+        return threads;
+    }
+    return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+std::vector<std::string_view> SplitAtLineBoundaries(std::string_view data, size_t count) {
+    std::vector<std::string_view> pieces;
+    if (data.empty()) {
+        return pieces;
+    }
+    count = std::max<size_t>(1, count);
+    const size_t target = (data.size() + count - 1) / count;
+
+    size_t begin = 0;
+    while (begin < data.size()) {
+        size_t end = data.size();
+        if (data.size() - begin > target) {
+            // Extend the cut to just after the next newline.
+            const char* newline = static_cast<const char*>(
+                std::memchr(data.data() + begin + target - 1, '\n', data.size() - begin - target + 1));
+            if (newline != nullptr) {
+                end = static_cast<size_t>(newline - data.data()) + 1;
+            }
+        }
+        pieces.push_back(data.substr(begin, end - begin));
+        begin = end;
+    }
+    return pieces;
+}
+
+bool ParallelForEachChunk(const std::filesystem::path& filename, const ChunkFunction& fn, size_t threads) {
+    MapOptions options;
+    options.will_need = true;
+    const auto mapped = MappedFile::Open(filename, options);
+    if (!mapped) {
+        return false;
+    }
+
+    threads = ResolveThreadCount(threads);
+    const std::string_view data = mapped->View();
+    // Several chunks per thread balance uneven lines across workers.
+    const size_t max_chunks = std::max<size_t>(1, data.size() / kMinChunkBytes);
+    const std::vector<std::string_view> chunks = SplitAtLineBoundaries(data, std::min(threads * 4, max_chunks));
+
+    std::atomic<size_t> next{0};
+    auto work = [&](size_t worker) {
+        for (size_t i = next.fetch_add(1); i < chunks.size(); i = next.fetch_add(1)) {
+            fn(worker, chunks[i]);
+        }
+    };
+
+    const size_t workers = std::min(threads, chunks.size());
+    std::vector<std::thread> pool;
+    pool.reserve(workers > 0 ? workers - 1 : 0);
+    for (size_t worker = 1; worker < workers; ++worker) {
+        pool.emplace_back(work, worker);
+    }
+    if (workers > 0) {
+        work(0);
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    return true;
+}
+
+bool ParallelForEachLine(const std::filesystem::path& filename, const LineFunction& fn, size_t threads) {
+    return ParallelForEachChunk(
+        filename,
+        [&fn](size_t, std::string_view chunk) {
+            LineReader reader(chunk);
+            std::string_view line;
+            while (reader.Next(&line)) {
+                fn(line);
+            }
+        },
+        threads);
+}
+
+}  // namespace utils
+}  // namespace cpp_utils
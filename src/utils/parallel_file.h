@@ -0,0 +1,147 @@
+/**
+ * @file parallel_file.h
+ * @brief Processes the contents of a file on several threads at once.
+ */
+
+#ifndef CPP_UTILS_LIB_SRC_UTILS_PARALLEL_FILE_H_
+#define CPP_UTILS_LIB_SRC_UTILS_PARALLEL_FILE_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "src/utils/line_reader.h"
+
+namespace cpp_utils {
+namespace utils {
+
+/**
+ * @brief The smallest chunk ParallelForEachChunk hands to a worker.
+ */
+inline constexpr size_t kMinChunkBytes = 1 << 20;
+
+/**
+ * @brief Processes one chunk of a file.
+ *
+ * The worker index is in [0, threads) and identifies the calling thread, so
+ * callers can keep per-thread state without locking.
+ */
+using ChunkFunction = std::function<void(size_t worker, std::string_view chunk)>;
+
+/**
+ * @brief Processes one line of a file; may be called from several threads.
+ */
+using LineFunction = std::function<void(std::string_view line)>;
+
+/**
+ * @brief Resolves a requested thread count, mapping 0 to the number of cores.
+ * @param threads The requested number of threads, or 0.
+ * @return The number of threads to use; at least 1.
+ */
+size_t ResolveThreadCount(size_t threads);
+
+/**
+ * @brief Splits data into pieces that each end just after a newline.
+ *
+ * Only the last piece may lack a trailing newline. Fewer pieces than
+ * requested are returned when the data has too few lines.
+ *
+ * @param data The data to split.
+ * @param count The desired number of pieces.
+ * @return The pieces, in order and covering all of data.
+ */
+std::vector<std::string_view> SplitAtLineBoundaries(std::string_view data, size_t count);
+
+/**
+ * @brief Memory-maps a file and hands newline-aligned chunks to worker threads.
+ *
+ * The file is cut into several chunks per thread and workers pull them
+ * dynamically, so uneven lines do not leave cores idle. Chunks are never
+ * smaller than kMinChunkBytes, which keeps small files on one thread.
+ *
+ * @param filename The path to the file.
+ * @param fn Called once per chunk; chunk order across workers is unspecified.
+ * @param threads The number of threads, or 0 for one per core.
+ * @return True if the file could be mapped, false otherwise.
+ */
+bool ParallelForEachChunk(const std::filesystem::path& filename, const ChunkFunction& fn, size_t threads = 0);
+
+/**
+ * @brief Calls fn for every line of a file, using several threads.
+ *
+ * Lines follow LineReader rules: no terminator and no trailing '\r'.
+ *
+ * @param filename The path to the file.
+ * @param fn Called once per line, concurrently from different threads.
+ * @param threads The number of threads, or 0 for one per core.
+ * @return True if the file could be mapped, false otherwise.
+ */
+bool ParallelForEachLine(const std::filesystem::path& filename, const LineFunction& fn, size_t threads = 0);
+
+/**
+ * @brief Folds every line of a file into per-thread state, then merges it.
+ *
+ * Each thread starts from a copy of init and folds its lines in with
+ * line_fn(State*, std::string_view); the partial states are then combined
+ * with merge_fn(State* into, const State& from) on the calling thread.
+ *
+ * @param filename The path to the file.
+ * @param init The initial state given to every thread.
+ * @param line_fn Folds one line into a thread's state.
+ * @param merge_fn Combines two partial states.
+ * @param threads The number of threads, or 0 for one per core.
+ * @return The merged state, or std::nullopt if the file could not be mapped.
+ */
+template <typename State, typename LineFn, typename MergeFn,
+          typename = std::enable_if_t<std::is_invocable_v<MergeFn&, State*, const State&>>>
+std::optional<State> ParallelReduceLines(const std::filesystem::path& filename, const State& init,
+                                         LineFn line_fn, MergeFn merge_fn, size_t threads = 0) {
+    threads = ResolveThreadCount(threads);
+    std::vector<State> states(threads, init);
+    const bool ok = ParallelForEachChunk(
+        filename,
+        [&](size_t worker, std::string_view chunk) {
+            LineReader reader(chunk);
+            std::string_view line;
+            while (reader.Next(&line)) {
+                line_fn(&states[worker], line);
+            }
+        },
+        threads);
+    if (!ok) {
+        return std::nullopt;
+    }
+    for (size_t i = 1; i < states.size(); ++i) {
+        merge_fn(&states[0], states[i]);
+    }
+    return std::move(states[0]);
+}
+
+/**
+ * @brief ParallelReduceLines for states with a Merge method, such as CounterTp.
+ *
+ * @code
+ * CounterTp<std::string, std::string_view> words([](std::string_view w) { return std::string(w); });
+ * auto counts = ParallelReduceLines(path, words, [](auto* counter, std::string_view line) {
+ *     for (std::string_view word : SplitRange(line, ' ')) counter->Count(word);
+ * });
+ * @endcode
+ */
+template <typename State, typename LineFn>
+std::optional<State> ParallelReduceLines(const std::filesystem::path& filename, const State& init,
+                                         LineFn line_fn, size_t threads = 0) {
+    return ParallelReduceLines(
+        filename, init, std::move(line_fn),
+        [](State* into, const State& from) { into->Merge(from); },
+        threads);
+}
+
+}  // namespace utils
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_SRC_UTILS_PARALLEL_FILE_H_
@@ -0,0 +1,80 @@
+/**
+ * @file serializer.h
+ * @brief Pluggable binary encoding of keys and values.
+ */
+
+#ifndef CPP_UTILS_LIB_SRC_UTILS_SERIALIZER_H_
+#define CPP_UTILS_LIB_SRC_UTILS_SERIALIZER_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "src/utils/varint.h"
+
+namespace cpp_utils {
+namespace utils {
+
+/**
+ * @brief Encodes and decodes values of type T.
+ *
+ * Specialize this template, or pass a class with the same two static
+ * members, to store other types:
+ *
+ * @code
+ * static void Encode(const T& value, std::string* out);        // Appends to out.
+ * static bool Decode(std::string_view* input, T* value);       // Consumes from input.
+ * @endcode
+ *
+ * Decode returns false on truncated or malformed input. Arithmetic types
+ * and std::string are supported out of the box.
+ */
+template <typename T, typename Enable = void>
+struct Serializer;
+
+/**
+ * @brief Stores arithmetic values as their fixed-width machine representation.
+ */
+template <typename T>
+struct Serializer<T, std::enable_if_t<std::is_arithmetic_v<T>>> {
+    static void Encode(const T& value, std::string* out) {
+        out->append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    static bool Decode(std::string_view* input, T* value) {
+        if (input->size() < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(value, input->data(), sizeof(T));
+        input->remove_prefix(sizeof(T));
+        return true;
+    }
+};
+
+/**
+ * @brief Stores strings as a varint length followed by the bytes.
+ */
+template <>
+struct Serializer<std::string> {
+    static void Encode(const std::string& value, std::string* out) {
+        PutVarint64(out, value.size());
+        out->append(value);
+    }
+
+    static bool Decode(std::string_view* input, std::string* value) {
+        uint64_t size = 0;
+        if (!GetVarint64(input, &size) || size > input->size()) {
+            return false;
+        }
+        value->assign(input->data(), static_cast<size_t>(size));
+        input->remove_prefix(static_cast<size_t>(size));
+        return true;
+    }
+};
+
+}  // namespace utils
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_SRC_UTILS_SERIALIZER_H_
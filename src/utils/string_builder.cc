@@ -0,0 +1,87 @@
+#include "src/utils/string_builder.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace cpp_utils {
+namespace utils {
+
+StringBuilder::StringBuilder(StringBuilder&& other) noexcept {
+    *this = std::move(other);
+}
+
+StringBuilder& StringBuilder::operator=(StringBuilder&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+    if (other.heap_) {
+        heap_ = std::move(other.heap_);
+        data_ = heap_.get();
+        capacity_ = other.capacity_;
+    } else {
+        heap_.reset();
+        std::memcpy(inline_, other.inline_, other.size_);
+        data_ = inline_;
+        capacity_ = kInlineCapacity;
+    }
+    size_ = other.size_;
+
+    other.data_ = other.inline_;
+    other.size_ = 0;
+    other.capacity_ = kInlineCapacity;
+    return *this;
+}
+
+StringBuilder& StringBuilder::Append(std::string_view s) {
+    if (!s.empty()) {
+        std::memcpy(Extend(s.size()), s.data(), s.size());
+    }
+    return *this;
+}
+
+StringBuilder& StringBuilder::Append(char c) {
+    *Extend(1) = c;
+    return *this;
+}
+
+StringBuilder& StringBuilder::AppendInt(int64_t value) {
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return Append(std::string_view(buffer, static_cast<size_t>(result.ptr - buffer)));
+}
+
+StringBuilder& StringBuilder::AppendUint(uint64_t value) {
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return Append(std::string_view(buffer, static_cast<size_t>(result.ptr - buffer)));
+}
+
+StringBuilder& StringBuilder::AppendDouble(double value) {
+    char buffer[32];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return Append(std::string_view(buffer, static_cast<size_t>(result.ptr - buffer)));
+}
+
+void StringBuilder::Reserve(size_t capacity) {
+    if (capacity <= capacity_) {
+        return;
+    }
+    std::unique_ptr<char[]> grown(new char[capacity]);
+    std::memcpy(grown.get(), data_, size_);
+    heap_ = std::move(grown);
+    data_ = heap_.get();
+    capacity_ = capacity;
+}
+
+char* StringBuilder::Extend(size_t extra) {
+    if (capacity_ - size_ < extra) {
+        Reserve(std::max(capacity_ * 2, size_ + extra));
+    }
+    char* out = data_ + size_;
+    size_ += extra;
+    return out;
+}
+
+}  // namespace utils
+}  // namespace cpp_utils
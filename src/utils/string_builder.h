@@ -0,0 +1,129 @@
+/**
+ * @file string_builder.h
+ * @brief An appendable string buffer with inline storage.
+ */
+
+#ifndef CPP_UTILS_LIB_SRC_UTILS_STRING_BUILDER_H_
+#define CPP_UTILS_LIB_SRC_UTILS_STRING_BUILDER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace cpp_utils {
+namespace utils {
+
+/**
+ * @brief Builds a string from many small appends.
+ *
+ * The first kInlineCapacity bytes live inside the object, so short outputs
+ * never touch the heap. Longer outputs grow geometrically, or exactly once
+ * when the final size is passed to Reserve().
+ */
+class StringBuilder {
+public:
+    static constexpr size_t kInlineCapacity = 128;
+
+    /**
+     * @brief Constructs an empty builder using the inline buffer.
+     */
+    StringBuilder() = default;
+
+    /**
+     * @brief Constructs an empty builder with room for at least capacity bytes.
+     * @param capacity The number of bytes to reserve.
+     */
+    explicit StringBuilder(size_t capacity) { Reserve(capacity); }
+
+    StringBuilder(const StringBuilder&) = delete;
+    StringBuilder& operator=(const StringBuilder&) = delete;
+
+    StringBuilder(StringBuilder&& other) noexcept;
+    StringBuilder& operator=(StringBuilder&& other) noexcept;
+
+    /**
+     * @brief Appends a string.
+     * @param s The string to append.
+     * @return This builder, for chaining.
+     */
+    StringBuilder& Append(std::string_view s);
+
+    /**
+     * @brief Appends a single character.
+     * @param c The character to append.
+     * @return This builder, for chaining.
+     */
+    StringBuilder& Append(char c);
+
+    /**
+     * @brief Appends the decimal form of a signed integer.
+     * @param value The value to append.
+     * @return This builder, for chaining.
+     */
+    StringBuilder& AppendInt(int64_t value);
+
+    /**
+     * @brief Appends the decimal form of an unsigned integer.
+     * @param value The value to append.
+     * @return This builder, for chaining.
+     */
+    StringBuilder& AppendUint(uint64_t value);
+
+    /**
+     * @brief Appends the shortest round-trippable form of a double.
+     * @param value The value to append.
+     * @return This builder, for chaining.
+     */
+    StringBuilder& AppendDouble(double value);
+
+    /**
+     * @brief Ensures room for at least capacity bytes in total.
+     * @param capacity The number of bytes to reserve.
+     */
+    void Reserve(size_t capacity);
+
+    /**
+     * @brief Removes the contents but keeps the allocated storage.
+     */
+    void Clear() { size_ = 0; }
+
+    /**
+     * @brief Gets the number of bytes appended so far.
+     * @return The size of the contents.
+     */
+    size_t Size() const { return size_; }
+
+    /**
+     * @brief Gets the number of bytes that fit without reallocating.
+     * @return The capacity.
+     */
+    size_t Capacity() const { return capacity_; }
+
+    /**
+     * @brief Gets a view of the contents, valid until the next modification.
+     * @return The contents.
+     */
+    std::string_view View() const { return std::string_view(data_, size_); }
+
+    /**
+     * @brief Copies the contents into a std::string.
+     * @return The contents.
+     */
+    std::string ToString() const { return std::string(data_, size_); }
+
+private:
+    // Makes room for `extra` more bytes and returns where they go.
+    char* Extend(size_t extra);
+
+    char inline_[kInlineCapacity];
+    std::unique_ptr<char[]> heap_;
+    char* data_ = inline_;
+    size_t size_ = 0;
+    size_t capacity_ = kInlineCapacity;
+};
+
+}  // namespace utils
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_SRC_UTILS_STRING_BUILDER_H_
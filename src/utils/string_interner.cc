@@ -0,0 +1,82 @@
+#include "src/utils/string_interner.h"
+
+#include <cstring>
+#include <mutex>
+
+namespace cpp_utils {
+namespace utils {
+
+StringInterner::StringInterner(size_t block_size) : block_size_(block_size > 0 ? block_size : 1) {}
+
+StringInterner::Id StringInterner::Intern(std::string_view s) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(s);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    // Another thread may have added it between the two locks.
+    auto it = ids_.find(s);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    const std::string_view stored = Store(s);
+    const auto id = static_cast<Id>(strings_.size());
+    strings_.push_back(stored);
+    ids_.emplace(stored, id);
+    return id;
+}
+
+std::optional<StringInterner::Id> StringInterner::Find(std::string_view s) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(s);
+    if (it == ids_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::string_view StringInterner::Lookup(Id id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return strings_.at(id);
+}
+
+size_t StringInterner::Size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return strings_.size();
+}
+
+size_t StringInterner::ArenaBytes() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return arena_bytes_;
+}
+
+std::string_view StringInterner::Store(std::string_view s) {
+    if (s.empty()) {
+        return std::string_view();
+    }
+    if (s.size() > block_size_) {
+        // Oversized strings get a dedicated block; the current block stays open.
+        blocks_.emplace_back(new char[s.size()]);
+        arena_bytes_ += s.size();
+        std::memcpy(blocks_.back().get(), s.data(), s.size());
+        return std::string_view(blocks_.back().get(), s.size());
+    }
+    if (remaining_ < s.size()) {
+        blocks_.emplace_back(new char[block_size_]);
+        arena_bytes_ += block_size_;
+        cursor_ = blocks_.back().get();
+        remaining_ = block_size_;
+    }
+    std::memcpy(cursor_, s.data(), s.size());
+    const std::string_view stored(cursor_, s.size());
+    cursor_ += s.size();
+    remaining_ -= s.size();
+    return stored;
+}
+
+}  // namespace utils
+}  // namespace cpp_utils
@@ -0,0 +1,100 @@
+/**
+ * @file string_interner.h
+ * @brief A thread-safe pool that stores each distinct string once.
+ */
+
+#ifndef CPP_UTILS_LIB_SRC_UTILS_STRING_INTERNER_H_
+#define CPP_UTILS_LIB_SRC_UTILS_STRING_INTERNER_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cpp_utils {
+namespace utils {
+
+/**
+ * @brief Maps strings to compact integer ids, storing each distinct string once.
+ *
+ * Strings are copied into an append-only arena of fixed-size blocks, so the
+ * views handed out stay valid for the lifetime of the interner. Ids are
+ * assigned densely from 0 in first-seen order and can be used as cheap keys
+ * for LRUCache or CounterTp. Lookups of already interned strings take a
+ * shared lock and run concurrently; only new strings take the exclusive lock.
+ */
+class StringInterner {
+public:
+    using Id = uint32_t;
+
+    /**
+     * @brief Constructs an empty interner.
+     * @param block_size The arena block size; longer strings get a block of their own.
+     */
+    explicit StringInterner(size_t block_size = 64 * 1024);
+
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    /**
+     * @brief Interns a string, adding it if it hasn't been seen before.
+     * @param s The string to intern.
+     * @return The string's id.
+     */
+    Id Intern(std::string_view s);
+
+    /**
+     * @brief Interns a string and returns the stored copy.
+     * @param s The string to intern.
+     * @return A view of the stored copy, valid for the interner's lifetime.
+     */
+    std::string_view InternView(std::string_view s) { return Lookup(Intern(s)); }
+
+    /**
+     * @brief Looks up the id of a string without adding it.
+     * @param s The string to look up.
+     * @return An optional containing the id if the string was interned, or std::nullopt otherwise.
+     */
+    std::optional<Id> Find(std::string_view s) const;
+
+    /**
+     * @brief Gets the string for an id.
+     * @param id An id returned by Intern().
+     * @return A view of the stored string, valid for the interner's lifetime.
+     */
+    std::string_view Lookup(Id id) const;
+
+    /**
+     * @brief Gets the number of distinct strings.
+     * @return The number of interned strings.
+     */
+    size_t Size() const;
+
+    /**
+     * @brief Gets the number of bytes reserved by the arena.
+     * @return The arena size in bytes.
+     */
+    size_t ArenaBytes() const;
+
+private:
+    // Copies s into the arena (assumes the exclusive lock is held).
+    std::string_view Store(std::string_view s);
+
+    const size_t block_size_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* cursor_ = nullptr;   // Next free byte in the current block.
+    size_t remaining_ = 0;     // Free bytes left in the current block.
+    size_t arena_bytes_ = 0;
+
+    std::unordered_map<std::string_view, Id> ids_;
+    std::vector<std::string_view> strings_;
+    mutable std::shared_mutex mutex_;
+};
+
+}  // namespace utils
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_SRC_UTILS_STRING_INTERNER_H_
@@ -0,0 +1,13 @@
+#include "src/utils/string_searcher.h"
+
+#include "src/utils/string_simd.h"
+
+namespace cpp_utils {
+namespace utils {
+
+size_t StringSearcher::Find(std::string_view haystack, size_t pos) const {
+    return internal::FindSubstring(haystack, pos, needle_);
+}
+
+}  // namespace utils
+}  // namespace cpp_utils
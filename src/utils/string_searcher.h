@@ -0,0 +1,63 @@
+/**
+ * @file string_searcher.h
+ * @brief A substring searcher reused across haystacks.
+ */
+
+#ifndef CPP_UTILS_LIB_SRC_UTILS_STRING_SEARCHER_H_
+#define CPP_UTILS_LIB_SRC_UTILS_STRING_SEARCHER_H_
+
+#include <string>
+#include <string_view>
+
+namespace cpp_utils {
+namespace utils {
+
+/**
+ * @brief Searches many haystacks for the same needle.
+ *
+ * Uses a vectorized first/last-byte filter (AVX2 or SSE2, chosen at
+ * runtime) so most positions are rejected 16-32 at a time, and falls back
+ * to memchr for single-byte needles. Candidates that pass the filter are
+ * verified with memcmp, so adversarial inputs where nearly every position
+ * passes cost O(n * m); there is no per-needle setup to amortize. The
+ * searcher owns a copy of the needle and is safe to share between threads.
+ */
+class StringSearcher {
+public:
+    /**
+     * @brief Creates a searcher for a needle.
+     * @param needle The string to search for.
+     */
+    explicit StringSearcher(std::string_view needle) : needle_(needle) {}
+
+    /**
+     * @brief Finds the first occurrence of the needle at or after pos.
+     * @param haystack The string to search.
+     * @param pos The position to start at.
+     * @return The position of the occurrence, or std::string_view::npos.
+     */
+    size_t Find(std::string_view haystack, size_t pos = 0) const;
+
+    /**
+     * @brief Checks whether the haystack contains the needle.
+     * @param haystack The string to search.
+     * @return True if the needle occurs in the haystack.
+     */
+    bool Contains(std::string_view haystack) const {
+        return Find(haystack) != std::string_view::npos;
+    }
+
+    /**
+     * @brief Gets the needle this searcher looks for.
+     * @return The needle.
+     */
+    std::string_view Needle() const { return needle_; }
+
+private:
+    std::string needle_;
+};
+
+}  // namespace utils
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_SRC_UTILS_STRING_SEARCHER_H_
@@ -0,0 +1,271 @@
+#include "src/utils/string_simd.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define CPP_UTILS_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace cpp_utils {
+namespace utils {
+namespace internal {
+namespace {
+
+using FindKernel = const char* (*)(const char* p, const char* end, const ByteSet& set);
+using CaseKernel = void (*)(const char* src, const char* end, char* dst, char first, char flip);
+// Substring kernels require needle_size >= 2 and return nullptr when there is no match.
+using SearchKernel = const char* (*)(const char* p, const char* end, const char* needle, size_t needle_size);
+
+const char* FindScalar(const char* p, const char* end, const ByteSet& set) {
+    for (; p < end; ++p) {
+        if (set.Contains(*p)) {
+            return p;
+        }
+    }
+    return end;
+}
+
+// Flips the 0x20 bit of every byte in [first, first + 25].
+void CaseScalar(const char* src, const char* end, char* dst, char first, char flip) {
+    for (; src < end; ++src, ++dst) {
+        const auto offset = static_cast<unsigned char>(*src - first);
+        *dst = offset < 26 ? static_cast<char>(*src ^ flip) : *src;
+    }
+}
+
+const char* SearchScalar(const char* p, const char* end, const char* needle, size_t needle_size) {
+    if (end - p < static_cast<std::ptrdiff_t>(needle_size)) {
+        return nullptr;
+    }
+    const char* last_start = end - needle_size;
+    while (p <= last_start) {
+        p = static_cast<const char*>(std::memchr(p, needle[0], static_cast<size_t>(last_start - p) + 1));
+        if (p == nullptr) {
+            return nullptr;
+        }
+        if (p[needle_size - 1] == needle[needle_size - 1] &&
+            std::memcmp(p + 1, needle + 1, needle_size - 2) == 0) {
+            return p;
+        }
+        ++p;
+    }
+    return nullptr;
+}
+
+#ifdef CPP_UTILS_X86_SIMD
+
+// The substring kernels compare each lane against the needle's first byte and
+// the lane needle_size - 1 bytes later against its last byte; only lanes that
+// match both are verified.
+const char* SearchSse2(const char* p, const char* end, const char* needle, size_t needle_size) {
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[needle_size - 1]);
+    while (end - p >= static_cast<std::ptrdiff_t>(needle_size - 1 + 16)) {
+        const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + needle_size - 1));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last))));
+        while (mask != 0) {
+            const char* candidate = p + __builtin_ctz(mask);
+            if (std::memcmp(candidate + 1, needle + 1, needle_size - 2) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+        p += 16;
+    }
+    return SearchScalar(p, end, needle, needle_size);
+}
+
+__attribute__((target("avx2")))
+const char* SearchAvx2(const char* p, const char* end, const char* needle, size_t needle_size) {
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[needle_size - 1]);
+    while (end - p >= static_cast<std::ptrdiff_t>(needle_size - 1 + 32)) {
+        const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + needle_size - 1));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last))));
+        while (mask != 0) {
+            const char* candidate = p + __builtin_ctz(mask);
+            if (std::memcmp(candidate + 1, needle + 1, needle_size - 2) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+        p += 32;
+    }
+    return SearchSse2(p, end, needle, needle_size);
+}
+
+// The vector case kernels shift the letter range down to start at -128 so a
+// single signed compare selects it.
+void CaseSse2(const char* src, const char* end, char* dst, char first, char flip) {
+    const __m128i shift = _mm_set1_epi8(static_cast<char>(-128 - first));
+    const __m128i limit = _mm_set1_epi8(-128 + 26);
+    const __m128i flip_bits = _mm_set1_epi8(flip);
+    while (end - src >= 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        const __m128i in_range = _mm_cmplt_epi8(_mm_add_epi8(block, shift), limit);
+        const __m128i converted = _mm_xor_si128(block, _mm_and_si128(in_range, flip_bits));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), converted);
+        src += 16;
+        dst += 16;
+    }
+    CaseScalar(src, end, dst, first, flip);
+}
+
+__attribute__((target("avx2")))
+void CaseAvx2(const char* src, const char* end, char* dst, char first, char flip) {
+    const __m256i shift = _mm256_set1_epi8(static_cast<char>(-128 - first));
+    const __m256i limit = _mm256_set1_epi8(-128 + 26);
+    const __m256i flip_bits = _mm256_set1_epi8(flip);
+    while (end - src >= 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        const __m256i in_range = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(block, shift));
+        const __m256i converted = _mm256_xor_si256(block, _mm256_and_si256(in_range, flip_bits));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), converted);
+        src += 32;
+        dst += 32;
+    }
+    CaseSse2(src, end, dst, first, flip);
+}
+
+const char* FindSse2(const char* p, const char* end, const ByteSet& set) {
+    const std::string_view bytes = set.Bytes();
+    __m128i needles[ByteSet::kMaxVectorBytes];
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        needles[i] = _mm_set1_epi8(bytes[i]);
+    }
+
+    while (end - p >= 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i hits = _mm_cmpeq_epi8(block, needles[0]);
+        for (size_t i = 1; i < bytes.size(); ++i) {
+            hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, needles[i]));
+        }
+        const int mask = _mm_movemask_epi8(hits);
+        if (mask != 0) {
+            return p + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+        p += 16;
+    }
+    return FindScalar(p, end, set);
+}
+
+__attribute__((target("avx2")))
+const char* FindAvx2(const char* p, const char* end, const ByteSet& set) {
+    const std::string_view bytes = set.Bytes();
+    __m256i needles[ByteSet::kMaxVectorBytes];
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        needles[i] = _mm256_set1_epi8(bytes[i]);
+    }
+
+    while (end - p >= 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i hits = _mm256_cmpeq_epi8(block, needles[0]);
+        for (size_t i = 1; i < bytes.size(); ++i) {
+            hits = _mm256_or_si256(hits, _mm256_cmpeq_epi8(block, needles[i]));
+        }
+        const int mask = _mm256_movemask_epi8(hits);
+        if (mask != 0) {
+            return p + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+        p += 32;
+    }
+    // The 16-byte kernel finishes the tail before dropping to scalar.
+    return FindSse2(p, end, set);
+}
+
+#endif  // CPP_UTILS_X86_SIMD
+
+struct Kernel {
+    FindKernel find;
+    CaseKernel convert_case;
+    SearchKernel search;
+    const char* name;
+};
+
+Kernel SelectKernel() {
+#ifdef CPP_UTILS_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return {FindAvx2, CaseAvx2, SearchAvx2, "avx2"};
+    }
+    return {FindSse2, CaseSse2, SearchSse2, "sse2"};
+#else
+    return {FindScalar, CaseScalar, SearchScalar, "scalar"};
+#endif
+}
+
+const Kernel& SelectedKernel() {
+    static const Kernel kernel = SelectKernel();
+    return kernel;
+}
+
+}  // namespace
+
+ByteSet::ByteSet(std::string_view bytes) {
+    for (char c : bytes) {
+        auto& present = table_[static_cast<unsigned char>(c)];
+        if (!present) {
+            present = true;
+            bytes_[size_++] = c;
+        }
+    }
+}
+
+size_t FindFirstOf(std::string_view s, size_t pos, const ByteSet& set) {
+    if (pos >= s.size()) {
+        return std::string_view::npos;
+    }
+    const char* end = s.data() + s.size();
+    const char* hit = set.Vectorizable()
+        ? SelectedKernel().find(s.data() + pos, end, set)
+        : FindScalar(s.data() + pos, end, set);
+    return hit == end ? std::string_view::npos : static_cast<size_t>(hit - s.data());
+}
+
+size_t FindFirstOfScalar(std::string_view s, size_t pos, const ByteSet& set) {
+    if (pos >= s.size()) {
+        return std::string_view::npos;
+    }
+    const char* end = s.data() + s.size();
+    const char* hit = FindScalar(s.data() + pos, end, set);
+    return hit == end ? std::string_view::npos : static_cast<size_t>(hit - s.data());
+}
+
+size_t FindSubstring(std::string_view haystack, size_t pos, std::string_view needle) {
+    if (pos > haystack.size() || needle.size() > haystack.size() - pos) {
+        return std::string_view::npos;
+    }
+    if (needle.empty()) {
+        return pos;
+    }
+    const char* begin = haystack.data() + pos;
+    const char* end = haystack.data() + haystack.size();
+    const char* hit;
+    if (needle.size() == 1) {
+        hit = static_cast<const char*>(std::memchr(begin, needle[0], static_cast<size_t>(end - begin)));
+    } else {
+        hit = SelectedKernel().search(begin, end, needle.data(), needle.size());
+    }
+    return hit == nullptr ? std::string_view::npos : static_cast<size_t>(hit - haystack.data());
+}
+
+void AsciiToLower(std::string_view src, char* dst) {
+    SelectedKernel().convert_case(src.data(), src.data() + src.size(), dst, 'A', 0x20);
+}
+
+void AsciiToUpper(std::string_view src, char* dst) {
+    SelectedKernel().convert_case(src.data(), src.data() + src.size(), dst, 'a', 0x20);
+}
+
+const char* SelectedKernelName() {
+    return SelectedKernel().name;
+}
+
+}  // namespace internal
+}  // namespace utils
+}  // namespace cpp_utils
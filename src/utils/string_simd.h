@@ -0,0 +1,117 @@
+/**
+ * @file string_simd.h
+ * @brief Vectorized byte scanning kernels used by the string utilities.
+ *
+ * The kernels are selected once at runtime: AVX2 when the CPU supports it,
+ * SSE2 on other x86-64 machines, and a portable scalar loop elsewhere.
+ */
+
+#ifndef CPP_UTILS_LIB_SRC_UTILS_STRING_SIMD_H_
+#define CPP_UTILS_LIB_SRC_UTILS_STRING_SIMD_H_
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace cpp_utils {
+namespace utils {
+namespace internal {
+
+/**
+ * @brief A set of bytes prepared once for repeated scanning.
+ *
+ * Sets of up to kMaxVectorBytes distinct bytes are searched with vector
+ * compares; larger sets fall back to a table lookup per byte.
+ */
+class ByteSet {
+public:
+    static constexpr size_t kMaxVectorBytes = 8;
+
+    /**
+     * @brief Builds a set from the given bytes; duplicates are ignored.
+     * @param bytes The bytes to search for.
+     */
+    explicit ByteSet(std::string_view bytes);
+
+    /**
+     * @brief Checks whether a byte belongs to the set.
+     * @param c The byte to check.
+     * @return True if the byte is in the set.
+     */
+    bool Contains(char c) const { return table_[static_cast<unsigned char>(c)]; }
+
+    /**
+     * @brief Gets the distinct bytes of the set.
+     * @return The distinct bytes, in first-seen order.
+     */
+    std::string_view Bytes() const { return std::string_view(bytes_.data(), size_); }
+
+    /**
+     * @brief Checks whether the set is small enough for the vector kernels.
+     * @return True if the vector kernels can be used.
+     */
+    bool Vectorizable() const { return size_ > 0 && size_ <= kMaxVectorBytes; }
+
+private:
+    std::array<bool, 256> table_{};
+    std::array<char, 256> bytes_{};
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Finds the first byte at or after pos that belongs to the set.
+ * @param s The string to scan.
+ * @param pos The position to start at.
+ * @param set The bytes to look for.
+ * @return The position of the first match, or std::string_view::npos.
+ */
+size_t FindFirstOf(std::string_view s, size_t pos, const ByteSet& set);
+
+/**
+ * @brief Scalar reference implementation of FindFirstOf.
+ * @param s The string to scan.
+ * @param pos The position to start at.
+ * @param set The bytes to look for.
+ * @return The position of the first match, or std::string_view::npos.
+ */
+size_t FindFirstOfScalar(std::string_view s, size_t pos, const ByteSet& set);
+
+/**
+ * @brief Finds the first occurrence of a needle at or after pos.
+ *
+ * Candidate positions are filtered 16-32 at a time by comparing the
+ * needle's first and last bytes against the haystack, and only candidates
+ * that pass both are verified with memcmp.
+ *
+ * @param haystack The string to search.
+ * @param pos The position to start at.
+ * @param needle The string to look for.
+ * @return The position of the first occurrence, or std::string_view::npos.
+ */
+size_t FindSubstring(std::string_view haystack, size_t pos, std::string_view needle);
+
+/**
+ * @brief Lowercases ASCII letters, leaving all other bytes untouched.
+ * @param src The bytes to convert.
+ * @param dst Where the converted bytes go; may equal src.data().
+ */
+void AsciiToLower(std::string_view src, char* dst);
+
+/**
+ * @brief Uppercases ASCII letters, leaving all other bytes untouched.
+ * @param src The bytes to convert.
+ * @param dst Where the converted bytes go; may equal src.data().
+ */
+void AsciiToUpper(std::string_view src, char* dst);
+
+/**
+ * @brief Names the kernel selected for this CPU.
+ * @return "avx2", "sse2" or "scalar".
+ */
+const char* SelectedKernelName();
+
+}  // namespace internal
+}  // namespace utils
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_SRC_UTILS_STRING_SIMD_H_
@@ -1,187 +1,284 @@
 #include "src/utils/string_utils.h"
 
 #include <algorithm>
-#include <cctype>
 #include <charconv>
-#include <sstream>
+#include <system_error>
+
+#include "src/utils/string_simd.h"
 
 namespace cpp_utils {
 namespace utils {
+namespace {
+
+bool IsSpace(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// std::from_chars rejects a leading '+', which the parsers have always accepted.
+std::string_view StripPlus(std::string_view s) {
+    if (s.size() > 1 && s[0] == '+' && s[1] != '-' && s[1] != '+') {
+        s.remove_prefix(1);
+    }
+    return s;
+}
+
+template <typename T>
+std::optional<T> ParseInteger(std::string_view s) {
+    s = StripPlus(TrimView(s));
+    T value{};
+    const auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+    if (s.empty() || ec != std::errc() || ptr != s.data() + s.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+template <typename T>
+std::optional<T> ParseFloat(std::string_view s) {
+    s = StripPlus(TrimView(s));
+    // Only plain decimal forms: the digits must start right after an optional sign.
+    const std::string_view mantissa = (!s.empty() && s[0] == '-') ? s.substr(1) : s;
+    if (mantissa.empty() || !(IsDigit(mantissa[0]) || mantissa[0] == '.')) {
+        return std::nullopt;
+    }
+    T value{};
+    const auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+    if (ec != std::errc() || ptr != s.data() + s.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+// Shared by the std::string and std::pmr::string overloads of Split.
+template <typename Vector>
+void SplitInto(std::string_view input, char delimiter, Vector* result) {
+    for (std::string_view piece : SplitLazy(input, delimiter)) {
+        result->emplace_back(piece);
+    }
+}
+
+// Shared by the std::string and std::pmr::string overloads of Replace. Copies
+// the text between matches and the replacements into the output in one
+// forward pass, instead of shifting the tail on every hit.
+template <typename String>
+void ReplaceInto(std::string_view s, std::string_view from, std::string_view to, bool replace_all,
+                 String* result) {
+    if (from.empty()) {
+        result->assign(s);
+        return;
+    }
+
+    result->reserve(s.size());
+    size_t start = 0;
+    size_t pos;
+    while ((pos = internal::FindSubstring(s, start, from)) != std::string_view::npos) {
+        result->append(s, start, pos - start);
+        result->append(to);
+        start = pos + from.size();
+        if (!replace_all) {
+            break;
+        }
+    }
+    result->append(s, start, std::string_view::npos);
+}
+
+template <typename T, typename Parser>
+std::optional<std::vector<T>> ParseColumn(const std::vector<std::string_view>& fields, Parser parse) {
+    std::vector<T> values;
+    values.reserve(fields.size());
+    for (std::string_view field : fields) {
+        auto value = parse(field);
+        if (!value) {
+            return std::nullopt;
+        }
+        values.push_back(*value);
+    }
+    return values;
+}
+
+}  // namespace
 
 std::vector<std::string> Split(std::string_view input, char delimiter) {
     std::vector<std::string> result;
-    
-    // Handle empty input
+    SplitInto(input, delimiter, &result);
+    return result;
+}
+
+std::pmr::vector<std::pmr::string> Split(std::string_view input, char delimiter,
+                                         std::pmr::memory_resource* resource) {
+    std::pmr::vector<std::pmr::string> result(resource);
+    SplitInto(input, delimiter, &result);
+    return result;
+}
+
+std::vector<std::string_view> SplitView(std::string_view input, char delimiter) {
+    std::vector<std::string_view> result;
+    SplitView(input, delimiter, &result);
+    return result;
+}
+
+size_t SplitView(std::string_view input, char delimiter, std::vector<std::string_view>* out) {
+    out->clear();
+    for (std::string_view piece : SplitLazy(input, delimiter)) {
+        out->push_back(piece);
+    }
+    return out->size();
+}
+
+std::vector<std::string_view> SplitAny(std::string_view input, std::string_view delimiters) {
+    std::vector<std::string_view> result;
     if (input.empty()) {
         return result;
     }
-    
-    std::string current;
-    
-    for (char c : input) {
-        if (c == delimiter) {
-            // Add current token to result, even if empty
-            result.push_back(current);
-            current.clear();
-        } else {
-            current += c;
-        }
+
+    const internal::ByteSet set(delimiters);
+    size_t start = 0;
+    size_t pos;
+    while ((pos = internal::FindFirstOf(input, start, set)) != std::string_view::npos) {
+        result.push_back(input.substr(start, pos - start));
+        start = pos + 1;
     }
-    
-    // Add the last token
-    result.push_back(current);
-    
+    result.push_back(input.substr(start));
     return result;
 }
 
-std::string Join(const std::vector<std::string>& strings, std::string_view delimiter) {
-    std::ostringstream result;
-    bool first = true;
-    
-    for (const auto& s : strings) {
-        if (!first) {
-            result << delimiter;
+std::vector<std::string> SplitCsv(std::string_view line, char delimiter, char quote) {
+    std::vector<std::string> result;
+    if (line.empty()) {
+        return result;
+    }
+
+    const internal::ByteSet delimiter_set(std::string_view(&delimiter, 1));
+    const internal::ByteSet quote_set(std::string_view(&quote, 1));
+    size_t pos = 0;
+    while (true) {
+        std::string field;
+        if (pos < line.size() && line[pos] == quote) {
+            // Quoted field: copy runs between quotes, turning "" into ".
+            ++pos;
+            while (true) {
+                const size_t close = internal::FindFirstOf(line, pos, quote_set);
+                if (close == std::string_view::npos) {
+                    field.append(line.substr(pos));
+                    pos = line.size();
+                    break;
+                }
+                field.append(line.substr(pos, close - pos));
+                pos = close + 1;
+                if (pos < line.size() && line[pos] == quote) {
+                    field.push_back(quote);
+                    ++pos;
+                } else {
+                    break;
+                }
+            }
         }
-        result << s;
-        first = false;
+
+        // Unquoted field, or stray text after a closing quote.
+        const size_t next = internal::FindFirstOf(line, pos, delimiter_set);
+        field.append(line.substr(pos, next == std::string_view::npos ? std::string_view::npos : next - pos));
+        result.push_back(std::move(field));
+        if (next == std::string_view::npos) {
+            break;
+        }
+        pos = next + 1;
     }
-    
-    return result.str();
+    return result;
+}
+
+std::string Join(const std::vector<std::string>& strings, std::string_view delimiter) {
+    return Join<std::vector<std::string>>(strings, delimiter);
 }
 
 std::string Trim(std::string_view s) {
-    auto start = s.begin();
-    while (start != s.end() && std::isspace(*start)) {
-        ++start;
+    return std::string(TrimView(s));
+}
+
+std::pmr::string Trim(std::string_view s, std::pmr::memory_resource* resource) {
+    return std::pmr::string(TrimView(s), resource);
+}
+
+std::string_view TrimView(std::string_view s) {
+    while (!s.empty() && IsSpace(s.front())) {
+        s.remove_prefix(1);
     }
-    
-    auto end = s.end();
-    while (start != end && std::isspace(*(end - 1))) {
-        --end;
+    while (!s.empty() && IsSpace(s.back())) {
+        s.remove_suffix(1);
     }
-    
-    return std::string(start, end);
+    return s;
 }
 
 std::string ToLower(std::string_view s) {
-    std::string result(s);
-    std::transform(result.begin(), result.end(), result.begin(),
-                  [](unsigned char c) { return std::tolower(c); });
+    std::string result(s.size(), '\0');
+    internal::AsciiToLower(s, result.data());
     return result;
 }
 
+void ToLowerInPlace(std::string* s) {
+    internal::AsciiToLower(*s, s->data());
+}
+
 std::string ToUpper(std::string_view s) {
-    std::string result(s);
-    std::transform(result.begin(), result.end(), result.begin(),
-                  [](unsigned char c) { return std::toupper(c); });
+    std::string result(s.size(), '\0');
+    internal::AsciiToUpper(s, result.data());
     return result;
 }
 
+void ToUpperInPlace(std::string* s) {
+    internal::AsciiToUpper(*s, s->data());
+}
+
 bool StartsWith(std::string_view s, std::string_view prefix) {
     return s.size() >= prefix.size() && s.substr(0, prefix.size()) == prefix;
 }
 
 bool EndsWith(std::string_view s, std::string_view suffix) {
-    return s.size() >= suffix.size() && 
-           s.substr(s.size() - suffix.size(), suffix.size()) == suffix;
+    return s.size() >= suffix.size() && s.substr(s.size() - suffix.size()) == suffix;
 }
 
 std::string Replace(std::string_view s, std::string_view from, std::string_view to, bool replace_all) {
-    if (from.empty()) return std::string(s);
-    
-    std::string result(s);
-    size_t pos = 0;
-    
-    // For replace_all, handle all occurrences
-    if (replace_all) {
-        while ((pos = result.find(from, pos)) != std::string::npos) {
-            result.replace(pos, from.length(), to);
-            pos += to.length();
-        }
-    } 
-    // For single replacement, handle just the first occurrence
-    else {
-        if ((pos = result.find(from, 0)) != std::string::npos) {
-            result.replace(pos, from.length(), to);
-        }
-    }
-    
+    std::string result;
+    ReplaceInto(s, from, to, replace_all, &result);
+    return result;
+}
+
+std::pmr::string Replace(std::string_view s, std::string_view from, std::string_view to, bool replace_all,
+                         std::pmr::memory_resource* resource) {
+    std::pmr::string result(resource);
+    ReplaceInto(s, from, to, replace_all, &result);
     return result;
 }
 
 std::optional<int> ToInt(std::string_view s) {
-    if (s.empty()) {
-        return std::nullopt;
-    }
-    
-    auto trimmed = Trim(s);
-    if (trimmed.empty()) {
-        return std::nullopt;
-    }
-    
-    // Check for non-numeric characters
-    for (char c : trimmed) {
-        if (c != '-' && c != '+' && !std::isdigit(static_cast<unsigned char>(c))) {
-            return std::nullopt;
-        }
-    }
-    
-    try {
-        int result = std::stoi(std::string(trimmed));
-        return result;
-    } catch (const std::exception&) {
-        return std::nullopt;
-    }
+    return ParseInteger<int>(s);
+}
+
+std::optional<int64_t> ToInt64(std::string_view s) {
+    return ParseInteger<int64_t>(s);
+}
+
+std::optional<uint64_t> ToUint64(std::string_view s) {
+    return ParseInteger<uint64_t>(s);
 }
 
 std::optional<double> ToDouble(std::string_view s) {
-    if (s.empty()) {
-        return std::nullopt;
-    }
-    
-    auto trimmed = Trim(s);
-    if (trimmed.empty()) {
-        return std::nullopt;
-    }
-    
-    // Check for valid floating-point format
-    bool has_digit = false;
-    bool has_dot = false;
-    bool has_exp = false;
-    
-    for (size_t i = 0; i < trimmed.size(); i++) {
-        char c = trimmed[i];
-        
-        if (std::isdigit(static_cast<unsigned char>(c))) {
-            has_digit = true;
-        } else if (c == '.') {
-            if (has_dot) {
-                return std::nullopt;  // Multiple decimal points
-            }
-            has_dot = true;
-        } else if (c == 'e' || c == 'E') {
-            if (has_exp || !has_digit) {
-                return std::nullopt;  // Multiple exponents or exponent without digits
-            }
-            has_exp = true;
-        } else if ((c == '-' || c == '+') && 
-                  (i == 0 || trimmed[i-1] == 'e' || trimmed[i-1] == 'E')) {
-            // Sign is allowed at the start or after an exponent
-        } else {
-            return std::nullopt;  // Invalid character
-        }
-    }
-    
-    if (!has_digit) {
-        return std::nullopt;  // No digits found
-    }
-    
-    try {
-        double result = std::stod(std::string(trimmed));
-        return result;
-    } catch (const std::exception&) {
-        return std::nullopt;
-    }
+    return ParseFloat<double>(s);
+}
+
+std::optional<float> ToFloat(std::string_view s) {
+    return ParseFloat<float>(s);
+}
+
+std::optional<std::vector<int64_t>> ToInt64Column(const std::vector<std::string_view>& fields) {
+    return ParseColumn<int64_t>(fields, ParseInteger<int64_t>);
+}
+
+std::optional<std::vector<double>> ToDoubleColumn(const std::vector<std::string_view>& fields) {
+    return ParseColumn<double>(fields, ParseFloat<double>);
 }
 
 }  // namespace utils
@@ -7,6 +7,11 @@
 #define CPP_UTILS_LIB_SRC_UTILS_STRING_UTILS_H_
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -23,6 +28,153 @@ namespace utils {
  */
 std::vector<std::string> Split(std::string_view input, char delimiter);
 
+/**
+ * @brief Splits a string by a delimiter, allocating the pieces from a memory resource.
+ * @param input The string to split.
+ * @param delimiter The delimiter to split by.
+ * @param resource The memory resource for the vector and its strings, e.g. an Arena.
+ * @return A vector of string pieces.
+ */
+std::pmr::vector<std::pmr::string> Split(std::string_view input, char delimiter,
+                                         std::pmr::memory_resource* resource);
+
+/**
+ * @brief Splits a string by a delimiter without copying the pieces.
+ * @param input The string to split. The returned views point into it.
+ * @param delimiter The delimiter to split by.
+ * @return A vector of views into the input.
+ */
+std::vector<std::string_view> SplitView(std::string_view input, char delimiter);
+
+/**
+ * @brief Splits a string by a delimiter into a caller-supplied buffer.
+ *
+ * The buffer is cleared first and its capacity is reused, so splitting many
+ * lines with the same buffer allocates nothing once it has grown.
+ *
+ * @param input The string to split. The stored views point into it.
+ * @param delimiter The delimiter to split by.
+ * @param out The buffer receiving the pieces.
+ * @return The number of pieces.
+ */
+size_t SplitView(std::string_view input, char delimiter, std::vector<std::string_view>* out);
+
+/**
+ * @brief A lazy, non-allocating range over the pieces of a delimited string.
+ *
+ * Produces the same pieces as Split(), one at a time, as views into the input.
+ */
+class SplitRange {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = const std::string_view&;
+
+        iterator() = default;
+
+        reference operator*() const { return current_; }
+        pointer operator->() const { return &current_; }
+
+        iterator& operator++() {
+            if (rest_ == nullptr) {
+                done_ = true;
+            } else {
+                Advance();
+            }
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const iterator& other) const {
+            return done_ == other.done_ && (done_ || current_.data() == other.current_.data());
+        }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class SplitRange;
+
+        iterator(std::string_view input, char delimiter)
+            : rest_(input.data()), end_(input.data() + input.size()), delimiter_(delimiter), done_(input.empty()) {
+            if (!done_) {
+                Advance();
+            }
+        }
+
+        // Cuts the next piece off the remaining input; rest_ becomes null after the last piece.
+        void Advance() {
+            const auto* hit = static_cast<const char*>(
+                std::memchr(rest_, delimiter_, static_cast<size_t>(end_ - rest_)));
+            if (hit == nullptr) {
+                current_ = std::string_view(rest_, static_cast<size_t>(end_ - rest_));
+                rest_ = nullptr;
+            } else {
+                current_ = std::string_view(rest_, static_cast<size_t>(hit - rest_));
+                rest_ = hit + 1;
+            }
+        }
+
+        std::string_view current_;
+        const char* rest_ = nullptr;
+        const char* end_ = nullptr;
+        char delimiter_ = '\0';
+        bool done_ = true;
+    };
+
+    SplitRange(std::string_view input, char delimiter) : input_(input), delimiter_(delimiter) {}
+
+    iterator begin() const { return iterator(input_, delimiter_); }
+    iterator end() const { return iterator(); }
+
+private:
+    std::string_view input_;
+    char delimiter_;
+};
+
+/**
+ * @brief Lazily splits a string by a delimiter.
+ * @param input The string to split. It must outlive the returned range.
+ * @param delimiter The delimiter to split by.
+ * @return A range yielding views into the input.
+ */
+inline SplitRange SplitLazy(std::string_view input, char delimiter) {
+    return SplitRange(input, delimiter);
+}
+
+/**
+ * @brief Splits a string at any of a set of delimiter bytes.
+ *
+ * Delimiters are located with vectorized scanning (AVX2/SSE2, selected at
+ * runtime), 16-32 bytes at a time.
+ *
+ * @param input The string to split. The returned views point into it.
+ * @param delimiters The bytes that separate pieces.
+ * @return A vector of views into the input.
+ */
+std::vector<std::string_view> SplitAny(std::string_view input, std::string_view delimiters);
+
+/**
+ * @brief Splits one line of CSV, honoring quoted fields.
+ *
+ * A field that starts with the quote character may contain delimiters, and
+ * a doubled quote inside it stands for one literal quote. Unterminated quotes
+ * run to the end of the line.
+ *
+ * @param line The line to split.
+ * @param delimiter The field delimiter.
+ * @param quote The quote character.
+ * @return The unquoted fields.
+ */
+std::vector<std::string> SplitCsv(std::string_view line, char delimiter = ',', char quote = '"');
+
 /**
  * @brief Joins a vector of strings with a delimiter.
  * @param strings The strings to join.
@@ -31,6 +183,41 @@ std::vector<std::string> Split(std::string_view input, char delimiter);
  */
 std::string Join(const std::vector<std::string>& strings, std::string_view delimiter);
 
+/**
+ * @brief Joins any range of string-like items with a delimiter.
+ *
+ * The output length is computed first, so the result is allocated once.
+ *
+ * @tparam Range A range whose items convert to std::string_view.
+ * @param pieces The items to join.
+ * @param delimiter The delimiter to join with.
+ * @return The joined string.
+ */
+template <typename Range>
+std::string Join(const Range& pieces, std::string_view delimiter) {
+    size_t total = 0;
+    size_t count = 0;
+    for (const auto& piece : pieces) {
+        total += std::string_view(piece).size();
+        ++count;
+    }
+    if (count > 1) {
+        total += delimiter.size() * (count - 1);
+    }
+
+    std::string result;
+    result.reserve(total);
+    bool first = true;
+    for (const auto& piece : pieces) {
+        if (!first) {
+            result.append(delimiter);
+        }
+        result.append(std::string_view(piece));
+        first = false;
+    }
+    return result;
+}
+
 /**
  * @brief Trims whitespace from both ends of a string.
  * @param s The string to trim.
@@ -38,6 +225,21 @@ std::string Join(const std::vector<std::string>& strings, std::string_view delim
  */
 std::string Trim(std::string_view s);
 
+/**
+ * @brief Trims whitespace from both ends of a string, allocating from a memory resource.
+ * @param s The string to trim.
+ * @param resource The memory resource for the result, e.g. an Arena.
+ * @return The trimmed string.
+ */
+std::pmr::string Trim(std::string_view s, std::pmr::memory_resource* resource);
+
+/**
+ * @brief Trims whitespace from both ends of a string without copying.
+ * @param s The string to trim.
+ * @return A view of the trimmed part of s.
+ */
+std::string_view TrimView(std::string_view s);
+
 /**
  * @brief Converts a string to lowercase.
  * @param s The string to convert.
@@ -45,6 +247,12 @@ std::string Trim(std::string_view s);
  */
 std::string ToLower(std::string_view s);
 
+/**
+ * @brief Converts ASCII letters in a string to lowercase in place.
+ * @param s The string to convert.
+ */
+void ToLowerInPlace(std::string* s);
+
 /**
  * @brief Converts a string to uppercase.
  * @param s The string to convert.
@@ -52,6 +260,12 @@ std::string ToLower(std::string_view s);
  */
 std::string ToUpper(std::string_view s);
 
+/**
+ * @brief Converts ASCII letters in a string to uppercase in place.
+ * @param s The string to convert.
+ */
+void ToUpperInPlace(std::string* s);
+
 /**
  * @brief Checks if a string starts with a prefix.
  * @param s The string to check.
@@ -78,20 +292,75 @@ bool EndsWith(std::string_view s, std::string_view suffix);
  */
 std::string Replace(std::string_view s, std::string_view from, std::string_view to, bool replace_all = false);
 
+/**
+ * @brief Replaces occurrences of a substring, allocating the result from a memory resource.
+ * @param s The original string.
+ * @param from The substring to replace.
+ * @param to The replacement substring.
+ * @param replace_all If true, replaces all occurrences; otherwise, only the first one.
+ * @param resource The memory resource for the result, e.g. an Arena.
+ * @return The modified string.
+ */
+std::pmr::string Replace(std::string_view s, std::string_view from, std::string_view to, bool replace_all,
+                         std::pmr::memory_resource* resource);
+
 /**
  * @brief Converts a string to an integer, handling errors gracefully.
+ *
+ * Surrounding whitespace and a leading '+' are accepted; anything else that
+ * is not part of the number, or a value out of range, is an error.
+ *
  * @param s The string to convert.
  * @return An optional containing the integer if conversion succeeded, or std::nullopt otherwise.
  */
 std::optional<int> ToInt(std::string_view s);
 
+/**
+ * @brief Converts a string to a 64-bit signed integer, handling errors gracefully.
+ * @param s The string to convert.
+ * @return An optional containing the integer if conversion succeeded, or std::nullopt otherwise.
+ */
+std::optional<int64_t> ToInt64(std::string_view s);
+
+/**
+ * @brief Converts a string to a 64-bit unsigned integer, handling errors gracefully.
+ * @param s The string to convert. Negative numbers are rejected.
+ * @return An optional containing the integer if conversion succeeded, or std::nullopt otherwise.
+ */
+std::optional<uint64_t> ToUint64(std::string_view s);
+
 /**
  * @brief Converts a string to a double, handling errors gracefully.
+ *
+ * Accepts decimal and scientific notation with surrounding whitespace;
+ * "inf", "nan" and hexadecimal forms are rejected.
+ *
  * @param s The string to convert.
  * @return An optional containing the double if conversion succeeded, or std::nullopt otherwise.
  */
 std::optional<double> ToDouble(std::string_view s);
 
+/**
+ * @brief Converts a string to a float, handling errors gracefully.
+ * @param s The string to convert.
+ * @return An optional containing the float if conversion succeeded, or std::nullopt otherwise.
+ */
+std::optional<float> ToFloat(std::string_view s);
+
+/**
+ * @brief Converts a column of fields to 64-bit signed integers.
+ * @param fields The fields to convert, e.g. from SplitView().
+ * @return An optional containing one value per field, or std::nullopt if any field fails to convert.
+ */
+std::optional<std::vector<int64_t>> ToInt64Column(const std::vector<std::string_view>& fields);
+
+/**
+ * @brief Converts a column of fields to doubles.
+ * @param fields The fields to convert, e.g. from SplitView().
+ * @return An optional containing one value per field, or std::nullopt if any field fails to convert.
+ */
+std::optional<std::vector<double>> ToDoubleColumn(const std::vector<std::string_view>& fields);
+
 }  // namespace utils
 }  // namespace cpp_utils
 
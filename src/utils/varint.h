@@ -0,0 +1,75 @@
+/**
+ * @file varint.h
+ * @brief LEB128 variable-length integer encoding helpers.
+ */
+
+#ifndef CPP_UTILS_LIB_SRC_UTILS_VARINT_H_
+#define CPP_UTILS_LIB_SRC_UTILS_VARINT_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace cpp_utils {
+namespace utils {
+
+/**
+ * @brief Maximum number of bytes a 64-bit varint can occupy.
+ */
+inline constexpr size_t kMaxVarint64Bytes = 10;
+
+/**
+ * @brief Appends an unsigned integer to a string as a varint (7 bits per byte).
+ * @param out The string to append to.
+ * @param value The value to encode.
+ */
+inline void PutVarint64(std::string* out, uint64_t value) {
+    while (value >= 0x80) {
+        out->push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    out->push_back(static_cast<char>(value));
+}
+
+/**
+ * @brief Reads a varint from the front of a buffer and advances the buffer past it.
+ * @param input The buffer to read from; consumed bytes are removed on success.
+ * @param value Receives the decoded value.
+ * @return True if a complete varint was decoded, false on truncated or overlong input.
+ */
+inline bool GetVarint64(std::string_view* input, uint64_t* value) {
+    uint64_t result = 0;
+    for (size_t i = 0; i < input->size() && i < kMaxVarint64Bytes; ++i) {
+        const auto byte = static_cast<uint8_t>((*input)[i]);
+        result |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+        if ((byte & 0x80) == 0) {
+            input->remove_prefix(i + 1);
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Maps a signed integer to an unsigned one so that small magnitudes encode compactly.
+ * @param value The signed value.
+ * @return The zigzag-encoded value.
+ */
+inline constexpr uint64_t ZigZagEncode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+/**
+ * @brief Inverse of ZigZagEncode.
+ * @param value The zigzag-encoded value.
+ * @return The original signed value.
+ */
+inline constexpr int64_t ZigZagDecode(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+}  // namespace utils
+}  // namespace cpp_utils
+
+#endif  // CPP_UTILS_LIB_SRC_UTILS_VARINT_H_
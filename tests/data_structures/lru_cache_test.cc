@@ -1,5 +1,9 @@
 #include "src/data_structures/lru_cache.h"
 
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
 #include <gtest/gtest.h>
 
 namespace cpp_utils {
@@ -152,6 +156,106 @@ TEST(LRUCacheTest, HeavyUsage) {
     }
 }
 
+TEST(LRUCacheTest, EvictionCallback) {
+    LRUCache<int, std::string> cache(2);
+    std::vector<std::pair<int, std::string>> evicted;
+    cache.SetEvictionCallback([&](const int& key, std::string&& value) {
+        evicted.emplace_back(key, std::move(value));
+    });
+
+    cache.Put(1, "one");
+    cache.Put(2, "two");
+    cache.Get(1);
+    cache.Put(3, "three");
+    ASSERT_EQ(1, evicted.size());
+    EXPECT_EQ(std::make_pair(2, std::string("two")), evicted[0]);
+
+    // Explicit removal is not eviction.
+    cache.Erase(1);
+    cache.Clear();
+    EXPECT_EQ(1, evicted.size());
+}
+
+TEST(LRUCacheTest, ForEachVisitsInRecencyOrder) {
+    LRUCache<int, std::string> cache(3);
+    cache.Put(1, "one");
+    cache.Put(2, "two");
+    cache.Put(3, "three");
+    cache.Get(1);
+
+    std::vector<int> keys;
+    cache.ForEach([&](const int& key, std::string& value) {
+        keys.push_back(key);
+        value += "!";
+    });
+    EXPECT_EQ((std::vector<int>{1, 3, 2}), keys);
+
+    const auto& const_cache = cache;
+    std::vector<std::string> values;
+    const_cache.ForEach([&](const int&, const std::string& value) { values.push_back(value); });
+    EXPECT_EQ((std::vector<std::string>{"one!", "three!", "two!"}), values);
+    // Visiting does not change the order.
+    keys.clear();
+    const_cache.ForEach([&](const int& key, const std::string&) { keys.push_back(key); });
+    EXPECT_EQ((std::vector<int>{1, 3, 2}), keys);
+}
+
+TEST(LRUCacheTest, SnapshotRoundTripKeepsRecencyOrder) {
+    const auto path = std::filesystem::temp_directory_path() / "cpp_utils_lru_snapshot_test.bin";
+    LRUCache<std::string, int> cache(4);
+    cache.Put("a", 1);
+    cache.Put("b", 2);
+    cache.Put("c", 3);
+    cache.Get("a");  // Recency: a, c, b.
+    ASSERT_TRUE(cache.SaveSnapshot(path));
+
+    LRUCache<std::string, int> restored(4);
+    restored.Put("stale", 0);
+    ASSERT_TRUE(restored.LoadSnapshot(path));
+    EXPECT_FALSE(restored.Contains("stale"));
+    std::vector<std::string> keys;
+    restored.ForEach([&](const std::string& key, int) { keys.push_back(key); });
+    EXPECT_EQ((std::vector<std::string>{"a", "c", "b"}), keys);
+    EXPECT_EQ(3, restored.Get("c").value_or(-1));
+
+    // A smaller cache keeps the most recent entries.
+    LRUCache<std::string, int> small(2);
+    ASSERT_TRUE(small.LoadSnapshot(path));
+    EXPECT_EQ(2, small.Size());
+    EXPECT_TRUE(small.Contains("a"));
+    EXPECT_TRUE(small.Contains("c"));
+    EXPECT_FALSE(small.Contains("b"));
+
+    std::filesystem::remove(path);
+}
+
+TEST(LRUCacheTest, SnapshotOfEmptyCache) {
+    const auto path = std::filesystem::temp_directory_path() / "cpp_utils_lru_empty_snapshot_test.bin";
+    LRUCache<int, int> cache(2);
+    ASSERT_TRUE(cache.SaveSnapshot(path));
+    cache.Put(1, 1);
+    ASSERT_TRUE(cache.LoadSnapshot(path));
+    EXPECT_EQ(0, cache.Size());
+    std::filesystem::remove(path);
+}
+
+TEST(LRUCacheTest, LoadSnapshotRejectsBadFiles) {
+    const auto path = std::filesystem::temp_directory_path() / "cpp_utils_lru_bad_snapshot_test.bin";
+    LRUCache<int, std::string> cache(4);
+    EXPECT_FALSE(cache.LoadSnapshot(path));
+
+    cache.Put(1, "one");
+    cache.Put(2, "two");
+    ASSERT_TRUE(cache.SaveSnapshot(path));
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_FALSE(cache.LoadSnapshot(path));
+    EXPECT_EQ(0, cache.Size());
+
+    ASSERT_TRUE(utils::WriteFile(path, "not a snapshot"));
+    EXPECT_FALSE(cache.LoadSnapshot(path));
+    std::filesystem::remove(path);
+}
+
 }  // namespace
 }  // namespace data_structures
 }  // namespace cpp_utils
@@ -0,0 +1,139 @@
+#include "src/data_structures/tiered_cache.h"
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <gtest/gtest.h>
+
+namespace cpp_utils {
+namespace data_structures {
+namespace {
+
+// Counts the values read back from disk.
+struct CountingSerializer {
+    static inline int decodes = 0;
+
+    static void Encode(const int& value, std::string* out) { utils::Serializer<int>::Encode(value, out); }
+
+    static bool Decode(std::string_view* input, int* value) {
+        ++decodes;
+        return utils::Serializer<int>::Decode(input, value);
+    }
+};
+
+class TieredCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir_ = std::filesystem::temp_directory_path() / "cpp_utils_tiered_cache_test";
+        std::filesystem::remove_all(test_dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(test_dir_);
+    }
+
+    std::filesystem::path test_dir_;
+};
+
+TEST_F(TieredCacheTest, SpillsEvictedEntriesAndPromotesThemBack) {
+    auto cache = TieredCache<int, std::string>::Open(2, test_dir_);
+    ASSERT_NE(nullptr, cache);
+
+    cache->Put(1, "one");
+    cache->Put(2, "two");
+    cache->Put(3, "three");  // Evicts 1 to disk.
+    EXPECT_EQ(2u, cache->MemorySize());
+    EXPECT_EQ(1u, cache->DiskSize());
+    EXPECT_TRUE(cache->Contains(1));
+
+    EXPECT_EQ("one", cache->Get(1).value_or("<missing>"));  // Promotes 1, evicts 2.
+    EXPECT_EQ(2u, cache->DiskSize());
+    EXPECT_EQ("two", cache->Get(2).value_or("<missing>"));
+    EXPECT_EQ("three", cache->Get(3).value_or("<missing>"));
+    EXPECT_FALSE(cache->Get(4).has_value());
+}
+
+TEST_F(TieredCacheTest, HoldsMoreThanTheMemoryTier) {
+    auto cache = TieredCache<std::string, std::string>::Open(10, test_dir_);
+    ASSERT_NE(nullptr, cache);
+    for (int i = 0; i < 1000; ++i) {
+        cache->Put("key" + std::to_string(i), "value" + std::to_string(i));
+    }
+    EXPECT_EQ(10u, cache->MemorySize());
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ("value" + std::to_string(i), cache->Get("key" + std::to_string(i)).value_or("<missing>"));
+    }
+}
+
+TEST_F(TieredCacheTest, UpdatesReachDiskAfterEviction) {
+    auto cache = TieredCache<int, int>::Open(1, test_dir_);
+    ASSERT_NE(nullptr, cache);
+    cache->Put(1, 10);
+    cache->Put(2, 20);          // Spills 1 = 10.
+    EXPECT_EQ(10, cache->Get(1).value_or(-1));  // Clean copy of 1; spills 2.
+    cache->Put(1, 11);
+    cache->Put(2, 21);          // Spills the update of 1.
+    EXPECT_EQ(11, cache->Get(1).value_or(-1));
+}
+
+TEST_F(TieredCacheTest, EraseRemovesFromBothTiers) {
+    auto cache = TieredCache<int, std::string>::Open(1, test_dir_);
+    ASSERT_NE(nullptr, cache);
+    cache->Put(1, "one");
+    cache->Put(2, "two");
+    EXPECT_TRUE(cache->Erase(1));
+    EXPECT_TRUE(cache->Erase(2));
+    EXPECT_FALSE(cache->Erase(3));
+    EXPECT_FALSE(cache->Contains(1));
+    EXPECT_FALSE(cache->Get(2).has_value());
+}
+
+TEST_F(TieredCacheTest, RestartsWarm) {
+    {
+        auto cache = TieredCache<int, std::string>::Open(3, test_dir_);
+        ASSERT_NE(nullptr, cache);
+        for (int i = 0; i < 10; ++i) {
+            cache->Put(i, std::to_string(i));
+        }
+        cache->Get(8);  // Memory now holds 8, 9, 7 from most to least recent.
+    }
+
+    auto cache = TieredCache<int, std::string>::Open(3, test_dir_);
+    ASSERT_NE(nullptr, cache);
+    EXPECT_EQ(3u, cache->MemorySize());
+    EXPECT_EQ(10u, cache->DiskSize());
+
+    // The restored order decides what is evicted next.
+    cache->Put(100, "new");
+    EXPECT_EQ(3u, cache->MemorySize());
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(std::to_string(i), cache->Get(i).value_or("<missing>"));
+    }
+}
+
+TEST_F(TieredCacheTest, RestoresRecencyOrder) {
+    {
+        auto cache = TieredCache<int, int, utils::Serializer<int>, CountingSerializer>::Open(3, test_dir_);
+        ASSERT_NE(nullptr, cache);
+        cache->Put(1, 1);
+        cache->Put(2, 2);
+        cache->Put(3, 3);
+        cache->Get(1);  // Recency: 1, 3, 2.
+    }
+    // With room for two entries, the two most recent ones come back.
+    auto cache = TieredCache<int, int, utils::Serializer<int>, CountingSerializer>::Open(2, test_dir_);
+    ASSERT_NE(nullptr, cache);
+    EXPECT_EQ(2u, cache->MemorySize());
+
+    // Hits in memory decode nothing; a miss reads and decodes from disk.
+    CountingSerializer::decodes = 0;
+    EXPECT_EQ(1, cache->Get(1).value_or(-1));
+    EXPECT_EQ(3, cache->Get(3).value_or(-1));
+    EXPECT_EQ(0, CountingSerializer::decodes);
+    EXPECT_EQ(2, cache->Get(2).value_or(-1));
+    EXPECT_EQ(1, CountingSerializer::decodes);
+}
+
+}  // namespace
+}  // namespace data_structures
+}  // namespace cpp_utils
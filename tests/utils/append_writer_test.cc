@@ -0,0 +1,149 @@
+#include "src/utils/append_writer.h"
+
+#include <sys/stat.h>
+
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "src/utils/file_utils.h"
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+class AppendWriterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir_ = std::filesystem::temp_directory_path() / "cpp_utils_append_writer_test";
+        std::filesystem::remove_all(test_dir_);
+        std::filesystem::create_directory(test_dir_);
+        path_ = test_dir_ / "log.txt";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(test_dir_);
+    }
+
+    std::string Contents() const { return ReadFile(path_).value_or("<missing>"); }
+
+    std::filesystem::path test_dir_;
+    std::filesystem::path path_;
+};
+
+TEST_F(AppendWriterTest, BuffersUntilFlush) {
+    auto writer = AppendWriter::Open(path_);
+    ASSERT_NE(nullptr, writer);
+    EXPECT_TRUE(writer->Append("one\n"));
+    EXPECT_TRUE(writer->Append("two\n"));
+    EXPECT_EQ("", Contents());
+    EXPECT_TRUE(writer->Flush());
+    EXPECT_EQ("one\ntwo\n", Contents());
+    EXPECT_TRUE(writer->Append("three\n"));
+    EXPECT_TRUE(writer->Sync());
+    EXPECT_EQ("one\ntwo\nthree\n", Contents());
+    EXPECT_EQ(14, writer->BytesAppended());
+}
+
+TEST_F(AppendWriterTest, AppendsToExistingFileAndFlushesOnDestruction) {
+    ASSERT_TRUE(WriteFile(path_, "old\n"));
+    {
+        auto writer = AppendWriter::Open(path_);
+        ASSERT_NE(nullptr, writer);
+        EXPECT_TRUE(writer->Append("new\n"));
+    }
+    EXPECT_EQ("old\nnew\n", Contents());
+}
+
+TEST_F(AppendWriterTest, FlushesWhenBufferFills) {
+    AppendOptions options;
+    options.buffer_size = 8;
+    auto writer = AppendWriter::Open(path_, options);
+    ASSERT_NE(nullptr, writer);
+    EXPECT_TRUE(writer->Append("abcd"));
+    EXPECT_EQ("", Contents());
+    EXPECT_TRUE(writer->Append("efgh"));
+    EXPECT_EQ("abcdefgh", Contents());
+    EXPECT_TRUE(writer->Append("ij"));
+    // Larger than the buffer: written straight through, after what was buffered.
+    EXPECT_TRUE(writer->Append("0123456789"));
+    EXPECT_EQ("abcdefghij0123456789", Contents());
+}
+
+TEST_F(AppendWriterTest, MultiPartRecords) {
+    AppendOptions options;
+    options.buffer_size = 16;
+    auto writer = AppendWriter::Open(path_, options);
+    ASSERT_NE(nullptr, writer);
+    EXPECT_TRUE(writer->Append({"key", "=", "value", "\n"}));
+    const std::string big(100, 'x');
+    EXPECT_TRUE(writer->Append({"big=", big, "\n"}));
+    EXPECT_TRUE(writer->Append({}));
+    EXPECT_TRUE(writer->Flush());
+    EXPECT_EQ("key=value\nbig=" + big + "\n", Contents());
+}
+
+TEST_F(AppendWriterTest, FlushInterval) {
+    AppendOptions options;
+    options.flush_interval = std::chrono::milliseconds(1);
+    auto writer = AppendWriter::Open(path_, options);
+    ASSERT_NE(nullptr, writer);
+    EXPECT_TRUE(writer->Append("a"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_TRUE(writer->Append("b"));
+    EXPECT_EQ("ab", Contents());
+}
+
+TEST_F(AppendWriterTest, ConcurrentAppendsKeepRecordsWhole) {
+    AppendOptions options;
+    options.buffer_size = 64;
+    options.sync_on_flush = true;
+    auto writer = AppendWriter::Open(path_, options);
+    ASSERT_NE(nullptr, writer);
+
+    constexpr int kThreads = 4;
+    constexpr int kRecords = 200;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            const std::string record(10, static_cast<char>('a' + t));
+            for (int i = 0; i < kRecords; ++i) {
+                writer->Append({record, "\n"});
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_TRUE(writer->Flush());
+
+    const auto lines = ReadLines(path_);
+    ASSERT_TRUE(lines.has_value());
+    ASSERT_EQ(static_cast<size_t>(kThreads * kRecords), lines->size());
+    for (const auto& line : *lines) {
+        EXPECT_EQ(std::string(10, line[0]), line);
+    }
+}
+
+TEST_F(AppendWriterTest, NewFileModeFollowsUmask) {
+    for (mode_t mask : {mode_t{002}, mode_t{077}}) {
+        std::filesystem::remove(path_);
+        const mode_t old_mask = ::umask(mask);
+        auto writer = AppendWriter::Open(path_);
+        ::umask(old_mask);
+        ASSERT_NE(nullptr, writer);
+        struct stat st;
+        ASSERT_EQ(0, ::stat(path_.c_str(), &st));
+        EXPECT_EQ(0666 & ~mask, st.st_mode & 0777) << std::oct << mask;
+    }
+}
+
+TEST_F(AppendWriterTest, OpenFailure) {
+    EXPECT_EQ(nullptr, AppendWriter::Open(test_dir_ / "missing_dir" / "log.txt"));
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace cpp_utils
@@ -0,0 +1,86 @@
+#include "src/utils/arena.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "src/utils/string_utils.h"
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+TEST(ArenaTest, AllocateAligned) {
+    Arena arena(256);
+    EXPECT_EQ(0, arena.BytesReserved());
+
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(8, 8);
+    void* c = arena.allocate(16, 16);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(b) % 8);
+    EXPECT_EQ(0, reinterpret_cast<uintptr_t>(c) % 16);
+    EXPECT_EQ(256, arena.BytesReserved());
+    EXPECT_GE(arena.BytesUsed(), 27);
+
+    // Oversized requests get their own block
+    void* big = arena.allocate(1000, 8);
+    EXPECT_NE(nullptr, big);
+    EXPECT_GE(arena.BytesReserved(), 1256);
+}
+
+TEST(ArenaTest, ResetReusesBlocks) {
+    Arena arena(128);
+    std::vector<void*> first_round;
+    for (int i = 0; i < 20; ++i) {
+        first_round.push_back(arena.allocate(32, 8));
+    }
+    const size_t reserved = arena.BytesReserved();
+
+    arena.Reset();
+    EXPECT_EQ(0, arena.BytesUsed());
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(first_round[i], arena.allocate(32, 8));
+    }
+    EXPECT_EQ(reserved, arena.BytesReserved());
+}
+
+TEST(ArenaTest, PmrContainers) {
+    Arena arena;
+    std::pmr::vector<std::pmr::string> strings(&arena);
+    for (int i = 0; i < 100; ++i) {
+        strings.emplace_back("a string long enough to skip small-string storage #" + std::to_string(i));
+    }
+    EXPECT_EQ(100, strings.size());
+    EXPECT_EQ("a string long enough to skip small-string storage #42", strings[42]);
+    EXPECT_GT(arena.BytesUsed(), 100 * 50);
+}
+
+TEST(ArenaTest, StringUtilsOverloads) {
+    Arena arena;
+    const std::string line = "  first field that is fairly long,second field that is fairly long,,x  ";
+
+    auto pieces = Split(line, ',', &arena);
+    ASSERT_EQ(4, pieces.size());
+    EXPECT_EQ("  first field that is fairly long", pieces[0]);
+    EXPECT_EQ("", pieces[2]);
+    EXPECT_EQ(&arena, pieces.get_allocator().resource());
+    EXPECT_EQ(&arena, pieces[1].get_allocator().resource());
+
+    auto trimmed = Trim(line, &arena);
+    EXPECT_EQ(Trim(line), std::string(trimmed));
+
+    auto replaced = Replace(line, "field", "column", true, &arena);
+    EXPECT_EQ(Replace(line, "field", "column", true), std::string(replaced));
+    EXPECT_EQ(&arena, replaced.get_allocator().resource());
+
+    const size_t used = arena.BytesUsed();
+    EXPECT_GT(used, 0);
+    arena.Reset();
+    EXPECT_EQ(0, arena.BytesUsed());
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace cpp_utils
@@ -0,0 +1,97 @@
+#include "src/utils/async_log_writer.h"
+
+#include <filesystem>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "src/utils/file_utils.h"
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+class AsyncLogWriterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir_ = std::filesystem::temp_directory_path() / "cpp_utils_async_log_writer_test";
+        std::filesystem::remove_all(test_dir_);
+        std::filesystem::create_directory(test_dir_);
+        path_ = test_dir_ / "log.txt";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(test_dir_);
+    }
+
+    std::filesystem::path test_dir_;
+    std::filesystem::path path_;
+};
+
+TEST_F(AsyncLogWriterTest, FutureCompletesAfterCommit) {
+    auto writer = AsyncLogWriter::Open(path_);
+    ASSERT_NE(nullptr, writer);
+    auto first = writer->Append("first\n");
+    auto second = writer->Append("second\n");
+    EXPECT_TRUE(first.get());
+    EXPECT_TRUE(second.get());
+    EXPECT_EQ("first\nsecond\n", ReadFile(path_).value_or(""));
+}
+
+TEST_F(AsyncLogWriterTest, DestructorDrainsPendingRecords) {
+    {
+        AsyncLogOptions options;
+        options.sync = false;
+        auto writer = AsyncLogWriter::Open(path_, options);
+        ASSERT_NE(nullptr, writer);
+        for (int i = 0; i < 100; ++i) {
+            writer->Append(std::to_string(i) + "\n");
+        }
+    }
+    const auto lines = ReadLines(path_);
+    ASSERT_TRUE(lines.has_value());
+    ASSERT_EQ(100, lines->size());
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(std::to_string(i), (*lines)[i]);
+    }
+}
+
+TEST_F(AsyncLogWriterTest, ProducersShareCommits) {
+    AsyncLogOptions options;
+    options.commit_delay = std::chrono::microseconds(200);
+    auto writer = AsyncLogWriter::Open(path_, options);
+    ASSERT_NE(nullptr, writer);
+
+    constexpr int kThreads = 8;
+    constexpr int kRecords = 50;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < kRecords; ++i) {
+                EXPECT_TRUE(writer->Append(std::to_string(t) + ":" + std::to_string(i) + "\n").get());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Every producer waits for its own commit, so without grouping there
+    // would be one batch per record.
+    EXPECT_LT(writer->BatchCount(), static_cast<uint64_t>(kThreads * kRecords));
+
+    const auto lines = ReadLines(path_);
+    ASSERT_TRUE(lines.has_value());
+    const std::set<std::string> unique(lines->begin(), lines->end());
+    EXPECT_EQ(static_cast<size_t>(kThreads * kRecords), unique.size());
+}
+
+TEST_F(AsyncLogWriterTest, OpenFailure) {
+    EXPECT_EQ(nullptr, AsyncLogWriter::Open(test_dir_ / "missing_dir" / "log.txt"));
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace cpp_utils
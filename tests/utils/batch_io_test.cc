@@ -0,0 +1,197 @@
+#include "src/utils/batch_io.h"
+
+#include <sys/stat.h>
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "src/utils/file_utils.h"
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+// Runs every test against both engines; the io_uring one may itself fall
+// back to threads on kernels without io_uring.
+class BatchIoTest : public ::testing::TestWithParam<bool> {
+protected:
+    void SetUp() override {
+        test_dir_ = std::filesystem::temp_directory_path() / "cpp_utils_batch_io_test";
+        std::filesystem::remove_all(test_dir_);
+        std::filesystem::create_directory(test_dir_);
+        options_.use_io_uring = GetParam();
+        options_.queue_depth = 8;
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(test_dir_);
+    }
+
+    std::filesystem::path test_dir_;
+    BatchIoOptions options_;
+};
+
+TEST_P(BatchIoTest, EngineSelection) {
+    BatchIo io(options_);
+    if (!GetParam()) {
+        EXPECT_STREQ("threads", io.EngineName());
+    } else {
+        EXPECT_TRUE(std::strcmp(io.EngineName(), "io_uring") == 0 ||
+                    std::strcmp(io.EngineName(), "threads") == 0);
+    }
+}
+
+TEST_P(BatchIoTest, ReadManyFiles) {
+    std::vector<std::filesystem::path> paths;
+    std::vector<std::string> expected;
+    for (int i = 0; i < 100; ++i) {
+        paths.push_back(test_dir_ / ("file" + std::to_string(i)));
+        expected.push_back(std::string(static_cast<size_t>(i) * 37, static_cast<char>('a' + i % 26)));
+        ASSERT_TRUE(WriteFile(paths.back(), expected.back()));
+    }
+    paths.push_back(test_dir_ / "missing");
+
+    BatchIo io(options_);
+    const auto results = io.ReadFiles(paths);
+    ASSERT_EQ(paths.size(), results.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_TRUE(results[i].has_value()) << i;
+        EXPECT_EQ(expected[i], *results[i]);
+    }
+    EXPECT_FALSE(results.back().has_value());
+}
+
+TEST_P(BatchIoTest, ReadLargeFile) {
+    const auto path = test_dir_ / "large";
+    std::string content(3 << 20, '\0');
+    for (size_t i = 0; i < content.size(); ++i) {
+        content[i] = static_cast<char>(i * 131 % 251);
+    }
+    ASSERT_TRUE(WriteFile(path, content));
+
+    BatchIo io(options_);
+    const auto results = io.ReadFiles({path});
+    ASSERT_TRUE(results[0].has_value());
+    EXPECT_EQ(content, *results[0]);
+}
+
+TEST_P(BatchIoTest, WriteManyFiles) {
+    std::vector<std::string> contents;
+    std::vector<std::pair<std::filesystem::path, std::string_view>> files;
+    for (int i = 0; i < 50; ++i) {
+        contents.push_back("contents of file " + std::to_string(i));
+    }
+    contents.push_back("");
+    for (size_t i = 0; i < contents.size(); ++i) {
+        files.emplace_back(test_dir_ / ("out" + std::to_string(i)), contents[i]);
+    }
+    // Existing contents are replaced.
+    ASSERT_TRUE(WriteFile(files[0].first, "old contents that are longer"));
+    files.emplace_back(test_dir_ / "missing_dir" / "out", "x");
+
+    BatchIo io(options_);
+    const auto results = io.WriteFiles(files);
+    ASSERT_EQ(files.size(), results.size());
+    for (size_t i = 0; i < contents.size(); ++i) {
+        EXPECT_TRUE(results[i]) << i;
+        EXPECT_EQ(contents[i], ReadFile(files[i].first).value_or("<missing>"));
+    }
+    EXPECT_FALSE(results.back());
+}
+
+TEST_P(BatchIoTest, NewFileModeFollowsUmask) {
+    const auto path = test_dir_ / "mode";
+    BatchIo io(options_);
+    for (mode_t mask : {mode_t{002}, mode_t{077}}) {
+        std::filesystem::remove(path);
+        const mode_t old_mask = ::umask(mask);
+        const auto results = io.WriteFiles({{path, "x"}});
+        ::umask(old_mask);
+        ASSERT_TRUE(results[0]);
+        struct stat st;
+        ASSERT_EQ(0, ::stat(path.c_str(), &st));
+        EXPECT_EQ(0666 & ~mask, st.st_mode & 0777) << std::oct << mask;
+    }
+}
+
+TEST_P(BatchIoTest, EmptyBatch) {
+    BatchIo io(options_);
+    EXPECT_TRUE(io.ReadFiles({}).empty());
+    EXPECT_TRUE(io.WriteFiles({}).empty());
+}
+
+size_t OpenFdCount() {
+    size_t count = 0;
+    for (auto it = std::filesystem::directory_iterator("/proc/self/fd"); it != std::filesystem::directory_iterator();
+         ++it) {
+        ++count;
+    }
+    return count;
+}
+
+// The ring is made to fail a few submissions in, with files in every stage
+// in flight; the batch must still complete without leaking fds.
+TEST_P(BatchIoTest, FailedSubmissionFallsBack) {
+    std::vector<std::string> contents;
+    std::vector<std::pair<std::filesystem::path, std::string_view>> files;
+    std::vector<std::filesystem::path> paths;
+    for (int i = 0; i < 40; ++i) {
+        contents.push_back(std::string(static_cast<size_t>(i) * 1000, static_cast<char>('a' + i % 26)));
+    }
+    for (size_t i = 0; i < contents.size(); ++i) {
+        paths.push_back(test_dir_ / ("file" + std::to_string(i)));
+        files.emplace_back(paths.back(), contents[i]);
+    }
+    paths.push_back(test_dir_ / "missing");
+
+    for (int fail_at : {1, 2, 5}) {
+        int submissions = 0;
+        options_.before_submit = [&]() { return ++submissions < fail_at; };
+        const size_t fds_before = OpenFdCount();
+        {
+            BatchIo io(options_);
+            const auto written = io.WriteFiles(files);
+            ASSERT_EQ(files.size(), written.size());
+            for (size_t i = 0; i < files.size(); ++i) {
+                EXPECT_TRUE(written[i]) << fail_at << " " << i;
+                EXPECT_EQ(contents[i], ReadFile(paths[i]).value_or("<missing>"));
+            }
+            EXPECT_STREQ("threads", io.EngineName());
+        }
+        EXPECT_EQ(fds_before, OpenFdCount()) << fail_at;
+
+        submissions = 0;
+        {
+            BatchIo io(options_);
+            const auto read = io.ReadFiles(paths);
+            ASSERT_EQ(paths.size(), read.size());
+            for (size_t i = 0; i < contents.size(); ++i) {
+                ASSERT_TRUE(read[i].has_value()) << fail_at << " " << i;
+                EXPECT_EQ(contents[i], *read[i]);
+            }
+            EXPECT_FALSE(read.back().has_value());
+        }
+        EXPECT_EQ(fds_before, OpenFdCount()) << fail_at;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Engines, BatchIoTest, ::testing::Bool());
+
+TEST(BatchIoFunctionsTest, RoundTrip) {
+    const auto dir = std::filesystem::temp_directory_path() / "cpp_utils_batch_io_functions_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directory(dir);
+    const auto written = WriteFiles({{dir / "a", "alpha"}, {dir / "b", "beta"}});
+    EXPECT_EQ((std::vector<bool>{true, true}), written);
+    const auto read = ReadFiles({dir / "a", dir / "b"});
+    EXPECT_EQ("alpha", read[0].value_or(""));
+    EXPECT_EQ("beta", read[1].value_or(""));
+    std::filesystem::remove_all(dir);
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace cpp_utils
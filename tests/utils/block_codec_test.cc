@@ -0,0 +1,83 @@
+#include "src/utils/block_codec.h"
+
+#include <random>
+#include <string>
+#include <gtest/gtest.h>
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+std::string RoundTrip(const std::string& input) {
+    std::string compressed;
+    CompressBlock(input, &compressed);
+    std::string output = "prefix";
+    EXPECT_TRUE(DecompressBlock(compressed, input.size(), &output));
+    return output.substr(6);
+}
+
+TEST(BlockCodecTest, SmallInputs) {
+    for (const std::string input : {"", "a", "abc", "abcd", "aaaaaaaa", "hello hello hello"}) {
+        EXPECT_EQ(input, RoundTrip(input));
+    }
+}
+
+TEST(BlockCodecTest, CompressesRepetitiveData) {
+    std::string input;
+    for (int i = 0; i < 2000; ++i) {
+        input += "2024-01-01 INFO request handled path=/api/v1/items status=200\n";
+    }
+    std::string compressed;
+    CompressBlock(input, &compressed);
+    EXPECT_LT(compressed.size(), input.size() / 10);
+    EXPECT_EQ(input, RoundTrip(input));
+
+    // Long runs exercise overlapping matches and extended lengths.
+    const std::string run(100000, 'x');
+    EXPECT_EQ(run, RoundTrip(run));
+}
+
+TEST(BlockCodecTest, RandomData) {
+    std::mt19937 rng(42);
+    for (size_t size : {15, 16, 255, 270, 1000, 70000, 300000}) {
+        std::string input(size, '\0');
+        // Few symbols give matches; all bytes give literal runs.
+        const int alphabet = size % 2 == 0 ? 4 : 256;
+        for (char& c : input) {
+            c = static_cast<char>(rng() % alphabet);
+        }
+        std::string compressed;
+        CompressBlock(input, &compressed);
+        EXPECT_LE(compressed.size(), input.size() + input.size() / 255 + 16);
+        EXPECT_EQ(input, RoundTrip(input)) << size;
+    }
+}
+
+TEST(BlockCodecTest, RejectsCorruptInput) {
+    const std::string input = "abcabcabcabcabcabcabcabc the end";
+    std::string compressed;
+    CompressBlock(input, &compressed);
+
+    std::string out = "keep";
+    EXPECT_FALSE(DecompressBlock(compressed, input.size() + 1, &out));
+    EXPECT_FALSE(DecompressBlock(compressed, input.size() - 1, &out));
+    EXPECT_FALSE(DecompressBlock(compressed.substr(0, compressed.size() / 2), input.size(), &out));
+    EXPECT_FALSE(DecompressBlock("", 0, &out));
+    // A match reaching back before the start of the output.
+    EXPECT_FALSE(DecompressBlock(std::string("\x10" "a" "\x05\x00", 4), 5, &out));
+    EXPECT_EQ("keep", out);
+
+    std::mt19937 rng(7);
+    for (int i = 0; i < 1000; ++i) {
+        std::string garbage = compressed;
+        garbage[rng() % garbage.size()] = static_cast<char>(rng());
+        std::string decoded;
+        if (DecompressBlock(garbage, input.size(), &decoded)) {
+            EXPECT_EQ(input.size(), decoded.size());
+        }
+    }
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace cpp_utils
@@ -0,0 +1,172 @@
+#include "src/utils/compressed_file.h"
+
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "src/utils/file_utils.h"
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+std::string LogText(size_t lines) {
+    std::string text;
+    for (size_t i = 0; i < lines; ++i) {
+        text += "event=" + std::to_string(i) + " user=alice action=login result=ok\n";
+    }
+    return text;
+}
+
+class CompressedFileTest : public ::testing::TestWithParam<Compression> {
+protected:
+    void SetUp() override {
+        if (!CompressionAvailable(GetParam())) {
+            GTEST_SKIP() << "format not compiled in";
+        }
+        test_dir_ = std::filesystem::temp_directory_path() / "cpp_utils_compressed_file_test";
+        std::filesystem::remove_all(test_dir_);
+        std::filesystem::create_directory(test_dir_);
+        path_ = test_dir_ / "data.z";
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(test_dir_);
+    }
+
+    std::filesystem::path test_dir_;
+    std::filesystem::path path_;
+};
+
+TEST_P(CompressedFileTest, RoundTrip) {
+    const std::string text = LogText(20000);
+    ASSERT_TRUE(WriteCompressedFile(path_, text, GetParam()));
+    if (GetParam() != Compression::kNone) {
+        EXPECT_LT(*GetFileSize(path_), text.size() / 4);
+    }
+    EXPECT_EQ(text, ReadCompressedFile(path_).value_or("<failed>"));
+
+    auto reader = CompressedReader::Open(path_);
+    ASSERT_NE(nullptr, reader);
+    EXPECT_EQ(GetParam(), reader->Format());
+}
+
+TEST_P(CompressedFileTest, IncompressibleAndEmptyData) {
+    std::mt19937 rng(1);
+    std::string random(600000, '\0');
+    for (char& c : random) {
+        c = static_cast<char>(rng());
+    }
+    ASSERT_TRUE(WriteCompressedFile(path_, random, GetParam()));
+    EXPECT_EQ(random, ReadCompressedFile(path_).value_or("<failed>"));
+
+    ASSERT_TRUE(WriteCompressedFile(path_, "", GetParam()));
+    EXPECT_EQ("", ReadCompressedFile(path_).value_or("<failed>"));
+}
+
+TEST_P(CompressedFileTest, StreamsLines) {
+    {
+        auto writer = CompressedWriter::Open(path_, GetParam());
+        ASSERT_NE(nullptr, writer);
+        for (int i = 0; i < 50000; ++i) {
+            ASSERT_TRUE(writer->Append("line " + std::to_string(i) + "\n"));
+        }
+    }
+    auto lines = OpenCompressedLines(path_, 64);
+    ASSERT_TRUE(lines.has_value());
+    std::string_view line;
+    int count = 0;
+    while (lines->Next(&line)) {
+        ASSERT_EQ("line " + std::to_string(count), line);
+        ++count;
+    }
+    EXPECT_EQ(50000, count);
+    EXPECT_FALSE(lines->HasError());
+}
+
+TEST_P(CompressedFileTest, AppendsAcrossReopens) {
+    for (int session = 0; session < 3; ++session) {
+        auto writer = CompressedWriter::Open(path_, GetParam());
+        ASSERT_NE(nullptr, writer);
+        ASSERT_TRUE(writer->Append("session " + std::to_string(session) + "\n"));
+        ASSERT_TRUE(writer->Sync());
+        ASSERT_TRUE(writer->Append("after sync\n"));
+    }
+    EXPECT_EQ("session 0\nafter sync\nsession 1\nafter sync\nsession 2\nafter sync\n",
+              ReadCompressedFile(path_).value_or("<failed>"));
+}
+
+TEST_P(CompressedFileTest, FlushMakesDataReadable) {
+    auto writer = CompressedWriter::Open(path_, GetParam());
+    ASSERT_NE(nullptr, writer);
+    ASSERT_TRUE(writer->Append("partial\n"));
+    ASSERT_TRUE(writer->Flush());
+    auto lines = OpenCompressedLines(path_);
+    ASSERT_TRUE(lines.has_value());
+    std::string_view line;
+    ASSERT_TRUE(lines->Next(&line));
+    EXPECT_EQ("partial", line);
+}
+
+TEST_P(CompressedFileTest, CloseEndsStream) {
+    auto writer = CompressedWriter::Open(path_, GetParam());
+    ASSERT_NE(nullptr, writer);
+    ASSERT_TRUE(writer->Append(LogText(100)));
+    ASSERT_TRUE(writer->Close());
+    // The stream is complete while the writer still exists.
+    EXPECT_EQ(LogText(100), ReadCompressedFile(path_).value_or("<failed>"));
+    EXPECT_FALSE(writer->Append("more"));
+    EXPECT_FALSE(writer->Flush());
+    EXPECT_FALSE(writer->Close());
+    writer.reset();
+    EXPECT_EQ(LogText(100), ReadCompressedFile(path_).value_or("<failed>"));
+}
+
+TEST_P(CompressedFileTest, CloseReportsWriteFailure) {
+    if (!std::filesystem::exists("/dev/full")) {
+        GTEST_SKIP() << "no /dev/full";
+    }
+    // The data fits in the write buffer, so only closing reaches the device.
+    auto writer = CompressedWriter::Open("/dev/full", GetParam());
+    ASSERT_NE(nullptr, writer);
+    ASSERT_TRUE(writer->Append("data"));
+    EXPECT_FALSE(writer->Close());
+    EXPECT_FALSE(WriteCompressedFile("/dev/full", "data", GetParam()));
+}
+
+INSTANTIATE_TEST_SUITE_P(Formats, CompressedFileTest,
+                         ::testing::Values(Compression::kNone, Compression::kBlock, Compression::kGzip));
+
+TEST(CompressedFileErrorsTest, CorruptAndMissingFiles) {
+    const auto dir = std::filesystem::temp_directory_path() / "cpp_utils_compressed_file_errors_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directory(dir);
+
+    EXPECT_EQ(nullptr, CompressedReader::Open(dir / "missing"));
+    EXPECT_FALSE(ReadCompressedFile(dir / "missing").has_value());
+
+    const auto path = dir / "data.czb";
+    ASSERT_TRUE(WriteCompressedFile(path, LogText(1000), Compression::kBlock));
+    auto contents = ReadFile(path);
+    ASSERT_TRUE(contents.has_value());
+
+    // Cut inside a block.
+    ASSERT_TRUE(WriteFile(path, contents->substr(0, contents->size() / 2)));
+    EXPECT_FALSE(ReadCompressedFile(path).has_value());
+
+    // Damage the block header.
+    std::string damaged = *contents;
+    damaged[5] = static_cast<char>(0xFF);
+    damaged[6] = static_cast<char>(0xFF);
+    ASSERT_TRUE(WriteFile(path, damaged));
+    EXPECT_FALSE(ReadCompressedFile(path).has_value());
+
+    EXPECT_EQ(nullptr, CompressedWriter::Open(dir / "missing_dir" / "x", Compression::kBlock));
+    std::filesystem::remove_all(dir);
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace cpp_utils
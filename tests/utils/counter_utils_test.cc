@@ -0,0 +1,184 @@
+#include "src/utils/counter_utils.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "src/utils/varint.h"
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+using WordCounter = CounterTp<std::string, std::string>;
+using IntCounter = CounterTp<int64_t, int64_t>;
+
+WordCounter MakeWordCounter() {
+    return WordCounter([](const std::string& word) { return word; });
+}
+
+IntCounter MakeIntCounter() {
+    return IntCounter([](const int64_t& value) { return value; });
+}
+
+TEST(CounterUtilsTest, MergeAndSubtract) {
+    auto a = MakeWordCounter();
+    a.Count("apple");
+    a.Count("apple");
+    a.Count("banana");
+
+    auto b = MakeWordCounter();
+    b.Count("apple");
+    b.Count("cherry");
+
+    a.Merge(b);
+    EXPECT_EQ(3, a.GetCountMap().at("apple"));
+    EXPECT_EQ(1, a.GetCountMap().at("banana"));
+    EXPECT_EQ(1, a.GetCountMap().at("cherry"));
+
+    a.Subtract(b);
+    EXPECT_EQ(2, a.GetCountMap().at("apple"));
+    EXPECT_EQ(1, a.GetCountMap().at("banana"));
+    // Keys whose count drops to zero are removed
+    EXPECT_EQ(0, a.GetCountMap().count("cherry"));
+}
+
+TEST(CounterUtilsTest, MergeAndSubtractSelf) {
+    auto a = MakeWordCounter();
+    a.Count("apple");
+    a.Count("apple");
+    a.Count("banana");
+
+    a.Merge(a);
+    EXPECT_EQ(2u, a.GetCountMap().size());
+    EXPECT_EQ(4, a.GetCountMap().at("apple"));
+    EXPECT_EQ(2, a.GetCountMap().at("banana"));
+
+    a.Subtract(a);
+    EXPECT_TRUE(a.GetCountMap().empty());
+}
+
+TEST(CounterUtilsTest, SerializeStringKeys) {
+    auto counter = MakeWordCounter();
+    for (const char* word : {"alpha", "alphabet", "alpine", "beta", "alpha", ""}) {
+        counter.Count(word);
+    }
+
+    auto restored = MakeWordCounter();
+    ASSERT_TRUE(restored.Deserialize(counter.Serialize()));
+    EXPECT_EQ(counter.GetCountMap(), restored.GetCountMap());
+
+    // Empty counter round-trips too
+    auto empty = MakeWordCounter();
+    ASSERT_TRUE(restored.Deserialize(empty.Serialize()));
+    EXPECT_TRUE(restored.GetCountMap().empty());
+}
+
+TEST(CounterUtilsTest, SerializeIntegralKeys) {
+    auto counter = MakeIntCounter();
+    for (int64_t v : {-1000000000000LL, -5LL, 0LL, 7LL, 7LL, 1LL << 40}) {
+        counter.Count(v);
+    }
+
+    const std::string data = counter.Serialize();
+    auto restored = MakeIntCounter();
+    ASSERT_TRUE(restored.Deserialize(data));
+    EXPECT_EQ(counter.GetCountMap(), restored.GetCountMap());
+
+    // Truncated and corrupted snapshots are rejected without touching the counter
+    EXPECT_FALSE(restored.Deserialize(std::string_view(data).substr(0, data.size() - 1)));
+    EXPECT_FALSE(restored.Deserialize(""));
+    EXPECT_FALSE(restored.Deserialize(data + "x"));
+    EXPECT_EQ(counter.GetCountMap(), restored.GetCountMap());
+}
+
+TEST(CounterUtilsTest, MergeSerialized) {
+    auto a = MakeIntCounter();
+    a.Count(1);
+    a.Count(2);
+
+    auto b = MakeIntCounter();
+    b.Count(2);
+    b.Count(3);
+
+    ASSERT_TRUE(a.MergeSerialized(b.Serialize()));
+    EXPECT_EQ(1, a.GetCountMap().at(1));
+    EXPECT_EQ(2, a.GetCountMap().at(2));
+    EXPECT_EQ(1, a.GetCountMap().at(3));
+}
+
+TEST(CounterUtilsTest, RejectsCountsOutsideInt32) {
+    auto a = MakeIntCounter();
+    a.Count(7);
+    for (int64_t count : {int64_t{1} << 31, -(int64_t{1} << 31) - 1, int64_t{1} << 40}) {
+        std::string snapshot(1, '\x01');  // Version.
+        PutVarint64(&snapshot, 1);        // Entries.
+        PutVarint64(&snapshot, 5);        // Key.
+        PutVarint64(&snapshot, ZigZagEncode(count));
+        EXPECT_FALSE(a.MergeSerialized(snapshot)) << count;
+    }
+    EXPECT_EQ(1u, a.GetCountMap().size());
+    EXPECT_EQ(1, a.GetCountMap().at(7));
+
+    std::string snapshot(1, '\x01');
+    PutVarint64(&snapshot, 1);
+    PutVarint64(&snapshot, 5);
+    PutVarint64(&snapshot, ZigZagEncode(-(int64_t{1} << 31)));
+    ASSERT_TRUE(a.MergeSerialized(snapshot));
+    EXPECT_EQ(-(int64_t{1} << 31), a.GetCountMap().at(5));
+}
+
+TEST(CounterUtilsTest, SaveAndLoadFile) {
+    const auto path = std::filesystem::temp_directory_path() / "cpp_utils_counter_test.bin";
+
+    auto counter = MakeWordCounter();
+    counter.Count("one");
+    counter.Count("two");
+    counter.Count("two");
+    ASSERT_TRUE(counter.SaveToFile(path));
+
+    auto restored = MakeWordCounter();
+    ASSERT_TRUE(restored.LoadFromFile(path));
+    EXPECT_EQ(counter.GetCountMap(), restored.GetCountMap());
+
+    std::filesystem::remove(path);
+    EXPECT_FALSE(restored.LoadFromFile(path));
+}
+
+TEST(CounterUtilsTest, WindowedCounterExpiresOldBuckets) {
+    using Clock = std::chrono::steady_clock;
+    using std::chrono::seconds;
+    WindowedCounterTp<std::string, std::string> counter(
+        [](const std::string& word) { return word; }, seconds(60), 6);
+    EXPECT_EQ(seconds(60), counter.Window());
+
+    const Clock::time_point start{};
+    counter.Count("a", start);
+    counter.Count("b", start + seconds(15));
+    counter.Count("a", start + seconds(35));
+    EXPECT_EQ(2, counter.GetCountMap().at("a"));
+    EXPECT_EQ(1, counter.GetCountMap().at("b"));
+
+    // The first bucket [0s, 10s) falls out of the window
+    counter.Advance(start + seconds(65));
+    EXPECT_EQ(1, counter.GetCountMap().at("a"));
+    EXPECT_EQ(1, counter.GetCountMap().at("b"));
+
+    counter.Advance(start + seconds(75));
+    EXPECT_EQ(0, counter.GetCountMap().count("b"));
+    EXPECT_EQ(1, counter.GetCountMap().at("a"));
+
+    // Late events are counted in the current bucket
+    counter.Count("c", start);
+    EXPECT_EQ(1, counter.GetCountMap().at("c"));
+
+    // Jumping past the whole window clears everything
+    counter.Advance(start + seconds(1000));
+    EXPECT_TRUE(counter.GetCountMap().empty());
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace cpp_utils
@@ -0,0 +1,126 @@
+#include "src/utils/directory_walker.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "src/utils/file_utils.h"
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+class DirectoryWalkerTest : public ::testing::TestWithParam<size_t> {
+protected:
+    void SetUp() override {
+        root_ = std::filesystem::temp_directory_path() / "cpp_utils_directory_walker_test";
+        std::filesystem::remove_all(root_);
+        // root/a.txt, root/b.dat, root/sub/c.txt, root/sub/deep/d.txt,
+        // root/sub/deep/e.log, root/other/, root/link -> sub
+        std::filesystem::create_directories(root_ / "sub" / "deep");
+        std::filesystem::create_directories(root_ / "other");
+        ASSERT_TRUE(WriteFile(root_ / "a.txt", "a"));
+        ASSERT_TRUE(WriteFile(root_ / "b.dat", "b"));
+        ASSERT_TRUE(WriteFile(root_ / "sub" / "c.txt", "c"));
+        ASSERT_TRUE(WriteFile(root_ / "sub" / "deep" / "d.txt", "d"));
+        ASSERT_TRUE(WriteFile(root_ / "sub" / "deep" / "e.log", "e"));
+        std::filesystem::create_directory_symlink(root_ / "sub", root_ / "link");
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(root_);
+    }
+
+    // Maps each reported path, relative to the root, to its type and depth.
+    std::map<std::string, std::pair<EntryType, size_t>> Walk(WalkOptions options) {
+        options.threads = GetParam();
+        std::map<std::string, std::pair<EntryType, size_t>> seen;
+        std::mutex mutex;
+        EXPECT_TRUE(WalkDirectory(root_, [&](const DirEntry& entry) {
+            std::lock_guard<std::mutex> lock(mutex);
+            const auto relative = std::filesystem::path(entry.path).lexically_relative(root_).string();
+            EXPECT_EQ(std::filesystem::path(entry.path).filename().string(), entry.name);
+            EXPECT_TRUE(seen.emplace(relative, std::make_pair(entry.type, entry.depth)).second) << relative;
+        }, options));
+        return seen;
+    }
+
+    std::filesystem::path root_;
+};
+
+TEST_P(DirectoryWalkerTest, ReportsEveryEntry) {
+    const auto seen = Walk(WalkOptions());
+    const std::map<std::string, std::pair<EntryType, size_t>> expected = {
+        {"a.txt", {EntryType::kFile, 0}},
+        {"b.dat", {EntryType::kFile, 0}},
+        {"link", {EntryType::kSymlink, 0}},
+        {"other", {EntryType::kDirectory, 0}},
+        {"sub", {EntryType::kDirectory, 0}},
+        {"sub/c.txt", {EntryType::kFile, 1}},
+        {"sub/deep", {EntryType::kDirectory, 1}},
+        {"sub/deep/d.txt", {EntryType::kFile, 2}},
+        {"sub/deep/e.log", {EntryType::kFile, 2}},
+    };
+    EXPECT_EQ(expected, seen);
+}
+
+TEST_P(DirectoryWalkerTest, MaxDepth) {
+    WalkOptions options;
+    options.max_depth = 0;
+    EXPECT_EQ(5, Walk(options).size());
+    options.max_depth = 1;
+    EXPECT_EQ(7, Walk(options).size());
+}
+
+TEST_P(DirectoryWalkerTest, FilterPrunesSubtrees) {
+    WalkOptions options;
+    options.filter = [](const DirEntry& entry) { return entry.name != "sub"; };
+    const auto seen = Walk(options);
+    EXPECT_EQ(4, seen.size());
+    EXPECT_EQ(0, seen.count("sub/c.txt"));
+}
+
+TEST_P(DirectoryWalkerTest, FindFiles) {
+    auto files = FindFiles(root_, ".txt", GetParam());
+    ASSERT_TRUE(files.has_value());
+    std::sort(files->begin(), files->end());
+    const std::vector<std::filesystem::path> expected = {
+        root_ / "a.txt", root_ / "sub" / "c.txt", root_ / "sub" / "deep" / "d.txt"};
+    EXPECT_EQ(expected, *files);
+
+    files = FindFiles(root_, {}, GetParam());
+    ASSERT_TRUE(files.has_value());
+    EXPECT_EQ(5, files->size());
+}
+
+TEST_P(DirectoryWalkerTest, MissingRoot) {
+    EXPECT_FALSE(WalkDirectory(root_ / "missing", [](const DirEntry&) {}, WalkOptions()));
+    EXPECT_FALSE(FindFiles(root_ / "a.txt", {}, GetParam()).has_value());
+}
+
+TEST_P(DirectoryWalkerTest, ManyDirectories) {
+    size_t expected_files = 0;
+    for (int i = 0; i < 20; ++i) {
+        const auto dir = root_ / "many" / std::to_string(i) / "nested";
+        std::filesystem::create_directories(dir);
+        for (int j = 0; j < i; ++j) {
+            ASSERT_TRUE(WriteFile(dir / (std::to_string(j) + ".txt"), "x"));
+            ++expected_files;
+        }
+    }
+    auto files = FindFiles(root_ / "many", ".txt", GetParam());
+    ASSERT_TRUE(files.has_value());
+    EXPECT_EQ(expected_files, files->size());
+    const std::set<std::filesystem::path> unique(files->begin(), files->end());
+    EXPECT_EQ(expected_files, unique.size());
+}
+
+INSTANTIATE_TEST_SUITE_P(Threads, DirectoryWalkerTest, ::testing::Values(1, 4));
+
+}  // namespace
+}  // namespace utils
+}  // namespace cpp_utils
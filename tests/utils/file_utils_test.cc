@@ -1,5 +1,7 @@
 #include "src/utils/file_utils.h"
 
+#include <sys/stat.h>
+
 #include <filesystem>
 #include <fstream>
 #include <string>
@@ -167,6 +169,68 @@ TEST_F(FileUtilsTest, ListFiles) {
     EXPECT_FALSE(result.has_value());
 }
 
+TEST_F(FileUtilsTest, WriteFileWithOptions) {
+    WriteOptions options;
+    options.sync = true;
+    options.preallocate = true;
+    const std::string large(5 << 20, 'z');
+    EXPECT_TRUE(WriteFile(test_file_, large, options));
+    EXPECT_EQ(large, ReadFile(test_file_).value_or(""));
+
+    // Shorter contents truncate the old ones.
+    EXPECT_TRUE(WriteFile(test_file_, "short", options));
+    EXPECT_EQ("short", ReadFile(test_file_).value_or(""));
+}
+
+TEST_F(FileUtilsTest, AtomicWriteFile) {
+    WriteOptions options;
+    options.atomic = true;
+    EXPECT_TRUE(WriteFile(test_file_, "first", options));
+    EXPECT_EQ("first", ReadFile(test_file_).value_or(""));
+
+    std::filesystem::permissions(test_file_, std::filesystem::perms::owner_read | std::filesystem::perms::owner_write);
+    EXPECT_TRUE(WriteFile(test_file_, "second version", options));
+    EXPECT_EQ("second version", ReadFile(test_file_).value_or(""));
+    EXPECT_EQ(std::filesystem::perms::owner_read | std::filesystem::perms::owner_write,
+              std::filesystem::status(test_file_).permissions());
+
+    // No temporary files are left behind, even after a failure.
+    EXPECT_FALSE(WriteFile(test_dir_ / "missing_dir" / "file.txt", "data", options));
+    EXPECT_FALSE(WriteFile(test_dir_, "data", options));
+    auto files = ListFiles(test_dir_);
+    ASSERT_TRUE(files.has_value());
+    ASSERT_EQ(1, files->size());
+    EXPECT_EQ(test_file_, (*files)[0]);
+}
+
+TEST_F(FileUtilsTest, WriteFileModes) {
+    auto mode_of = [](const std::filesystem::path& path) {
+        struct stat st;
+        return ::stat(path.c_str(), &st) == 0 ? st.st_mode & 07777 : ~mode_t{0};
+    };
+    WriteOptions atomic;
+    atomic.atomic = true;
+
+    // New files get 0666 less the umask, whichever way they are written.
+    for (mode_t mask : {mode_t{002}, mode_t{077}}) {
+        const mode_t old_mask = ::umask(mask);
+        std::filesystem::remove(test_file_);
+        EXPECT_TRUE(WriteFile(test_file_, "plain"));
+        EXPECT_EQ(0666 & ~mask, mode_of(test_file_)) << std::oct << mask;
+        std::filesystem::remove(test_file_);
+        EXPECT_TRUE(WriteFile(test_file_, "atomic", atomic));
+        EXPECT_EQ(0666 & ~mask, mode_of(test_file_)) << std::oct << mask;
+        ::umask(old_mask);
+    }
+
+    // An atomic rewrite keeps the target's mode even where the umask would narrow it.
+    ASSERT_EQ(0, ::chmod(test_file_.c_str(), 0664));
+    const mode_t old_mask = ::umask(077);
+    EXPECT_TRUE(WriteFile(test_file_, "again", atomic));
+    ::umask(old_mask);
+    EXPECT_EQ(0664u, mode_of(test_file_));
+}
+
 }  // namespace
 }  // namespace utils
 }  // namespace cpp_utils
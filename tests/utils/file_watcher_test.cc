@@ -0,0 +1,205 @@
+#include "src/utils/file_watcher.h"
+
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "src/utils/file_utils.h"
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+using std::chrono::milliseconds;
+
+class FileWatcherTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir_ = std::filesystem::temp_directory_path() / "cpp_utils_file_watcher_test";
+        std::filesystem::remove_all(test_dir_);
+        std::filesystem::create_directory(test_dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(test_dir_);
+    }
+
+    // Consumes events until one of the given type for path arrives, or times out.
+    bool WaitFor(WatchEventQueue* queue, WatchEventType type, const std::filesystem::path& path) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (std::chrono::steady_clock::now() < deadline) {
+            while (!pending_.empty()) {
+                seen_.push_back(pending_.front());
+                pending_.pop_front();
+                if (seen_.back().type == type && seen_.back().path == path) {
+                    return true;
+                }
+            }
+            if (auto batch = queue->PopWithTimeout(milliseconds(100))) {
+                pending_.insert(pending_.end(), batch->begin(), batch->end());
+            }
+        }
+        return false;
+    }
+
+    std::filesystem::path test_dir_;
+    std::deque<WatchEvent> pending_;
+    std::vector<WatchEvent> seen_;
+};
+
+TEST_F(FileWatcherTest, ReportsDirectoryChanges) {
+    WatchEventQueue queue;
+    auto watcher = FileWatcher::Create(&queue);
+    ASSERT_NE(nullptr, watcher);
+    ASSERT_TRUE(watcher->AddWatch(test_dir_));
+
+    const auto file = test_dir_ / "input.txt";
+    ASSERT_TRUE(WriteFile(file, "data"));
+    EXPECT_TRUE(WaitFor(&queue, WatchEventType::kCreated, file));
+    EXPECT_TRUE(WaitFor(&queue, WatchEventType::kClosedWrite, file));
+
+    const auto renamed = test_dir_ / "renamed.txt";
+    std::filesystem::rename(file, renamed);
+    EXPECT_TRUE(WaitFor(&queue, WatchEventType::kMovedFrom, file));
+    EXPECT_TRUE(WaitFor(&queue, WatchEventType::kMovedTo, renamed));
+
+    std::filesystem::create_directory(test_dir_ / "sub");
+    ASSERT_TRUE(WaitFor(&queue, WatchEventType::kCreated, test_dir_ / "sub"));
+    EXPECT_TRUE(seen_.back().is_directory);
+
+    std::filesystem::remove(renamed);
+    EXPECT_TRUE(WaitFor(&queue, WatchEventType::kDeleted, renamed));
+}
+
+TEST_F(FileWatcherTest, MergesRepeatedWritesInABatch) {
+    const auto file = test_dir_ / "log.txt";
+    ASSERT_TRUE(WriteFile(file, ""));
+
+    WatchEventQueue queue;
+    auto watcher = FileWatcher::Create(&queue);
+    ASSERT_NE(nullptr, watcher);
+    ASSERT_TRUE(watcher->AddWatch(file));
+    for (int i = 0; i < 50; ++i) {
+        ASSERT_TRUE(AppendToFile(file, "line\n"));
+    }
+    ASSERT_TRUE(WaitFor(&queue, WatchEventType::kClosedWrite, file));
+    size_t modified = 0;
+    for (const auto& event : seen_) {
+        modified += event.type == WatchEventType::kModified;
+    }
+    EXPECT_GE(modified, 1);
+    EXPECT_LE(modified, 50);
+}
+
+TEST_F(FileWatcherTest, MergesInterleavedWritesInABatch) {
+    const auto first = test_dir_ / "first.txt";
+    const auto second = test_dir_ / "second.txt";
+    ASSERT_TRUE(WriteFile(first, ""));
+    ASSERT_TRUE(WriteFile(second, ""));
+
+    WatchEventQueue queue;
+    auto watcher = FileWatcher::Create(&queue);
+    ASSERT_NE(nullptr, watcher);
+    ASSERT_TRUE(watcher->AddWatch(test_dir_));
+    {
+        std::ofstream first_out(first, std::ios::app);
+        std::ofstream second_out(second, std::ios::app);
+        for (int i = 0; i < 500; ++i) {
+            first_out << "line\n" << std::flush;
+            second_out << "line\n" << std::flush;
+        }
+    }
+
+    // The kernel only merges identical events that are adjacent; the
+    // watcher must also merge across writes to other files.
+    size_t closed = 0;
+    size_t modified = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (closed < 2 && std::chrono::steady_clock::now() < deadline) {
+        auto batch = queue.PopWithTimeout(milliseconds(100));
+        if (!batch) {
+            continue;
+        }
+        std::map<std::filesystem::path, WatchEventType> last;
+        for (const auto& event : *batch) {
+            if (event.type == WatchEventType::kModified) {
+                ++modified;
+                auto it = last.find(event.path);
+                EXPECT_FALSE(it != last.end() && it->second == WatchEventType::kModified) << event.path;
+            }
+            closed += event.type == WatchEventType::kClosedWrite;
+            last[event.path] = event.type;
+        }
+    }
+    EXPECT_EQ(2, closed);
+    EXPECT_GE(modified, 2);
+}
+
+TEST_F(FileWatcherTest, AddAndRemoveWatch) {
+    WatchEventQueue queue;
+    auto watcher = FileWatcher::Create(&queue);
+    ASSERT_NE(nullptr, watcher);
+    EXPECT_FALSE(watcher->AddWatch(test_dir_ / "missing"));
+    EXPECT_FALSE(watcher->RemoveWatch(test_dir_));
+    ASSERT_TRUE(watcher->AddWatch(test_dir_));
+    EXPECT_TRUE(watcher->RemoveWatch(test_dir_));
+
+    ASSERT_TRUE(WriteFile(test_dir_ / "unwatched.txt", "x"));
+    auto batch = queue.PopWithTimeout(milliseconds(200));
+    if (batch) {
+        for (const auto& event : *batch) {
+            EXPECT_NE(test_dir_ / "unwatched.txt", event.path);
+        }
+    }
+}
+
+TEST_F(FileWatcherTest, TailerFollowsGrowingFile) {
+    const auto file = test_dir_ / "tail.txt";
+    ASSERT_TRUE(WriteFile(file, "existing\n"));
+
+    auto tailer = FileTailer::Open(file);
+    ASSERT_NE(nullptr, tailer);
+    std::string data;
+    EXPECT_EQ(9, tailer->Read(&data, milliseconds(0)).value_or(0));
+    EXPECT_EQ("existing\n", data);
+    EXPECT_EQ(0, tailer->Read(&data, milliseconds(10)).value_or(99));
+
+    std::thread writer([&file] {
+        std::this_thread::sleep_for(milliseconds(20));
+        AppendToFile(file, "appended\n");
+    });
+    data.clear();
+    EXPECT_EQ(9, tailer->Read(&data, std::chrono::seconds(5)).value_or(0));
+    writer.join();
+    EXPECT_EQ("appended\n", data);
+    EXPECT_EQ(18, tailer->Offset());
+
+    // Truncation restarts from the beginning.
+    ASSERT_TRUE(WriteFile(file, "new\n"));
+    data.clear();
+    EXPECT_EQ(4, tailer->Read(&data, std::chrono::seconds(1)).value_or(0));
+    EXPECT_EQ("new\n", data);
+}
+
+TEST_F(FileWatcherTest, TailerFromEnd) {
+    const auto file = test_dir_ / "tail.txt";
+    ASSERT_TRUE(WriteFile(file, "skipped\n"));
+    auto tailer = FileTailer::Open(file, true);
+    ASSERT_NE(nullptr, tailer);
+    ASSERT_TRUE(AppendToFile(file, "seen\n"));
+    std::string data;
+    EXPECT_EQ(5, tailer->Read(&data, std::chrono::seconds(1)).value_or(0));
+    EXPECT_EQ("seen\n", data);
+
+    EXPECT_EQ(nullptr, FileTailer::Open(test_dir_ / "missing.txt"));
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace cpp_utils
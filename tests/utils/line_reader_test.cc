@@ -0,0 +1,135 @@
+#include "src/utils/line_reader.h"
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "src/utils/file_utils.h"
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+std::vector<std::string> ReadAll(LineReader* reader) {
+    std::vector<std::string> lines;
+    std::string_view line;
+    while (reader->Next(&line)) {
+        lines.emplace_back(line);
+    }
+    return lines;
+}
+
+class LineReaderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir_ = std::filesystem::temp_directory_path() / "cpp_utils_line_reader_test";
+        std::filesystem::remove_all(test_dir_);
+        std::filesystem::create_directory(test_dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(test_dir_);
+    }
+
+    std::filesystem::path test_dir_;
+};
+
+TEST_F(LineReaderTest, MatchesReadLines) {
+    const auto path = test_dir_ / "lines.txt";
+    ASSERT_TRUE(WriteFile(path, "line1\nline2\n\nline4"));
+
+    auto reader = LineReader::Open(path);
+    ASSERT_TRUE(reader.has_value());
+    EXPECT_EQ(ReadLines(path), ReadAll(&*reader));
+    EXPECT_EQ(4, reader->LineCount());
+    EXPECT_FALSE(reader->HasError());
+}
+
+TEST_F(LineReaderTest, StripsCarriageReturns) {
+    LineReader reader(std::string_view("a\r\nb\r\n\r\nc\r"));
+    EXPECT_EQ((std::vector<std::string>{"a", "b", "", "c"}), ReadAll(&reader));
+}
+
+TEST_F(LineReaderTest, TrailingNewlineAndEmptyInput) {
+    LineReader trailing(std::string_view("a\nb\n"));
+    EXPECT_EQ((std::vector<std::string>{"a", "b"}), ReadAll(&trailing));
+
+    LineReader empty(std::string_view(""));
+    EXPECT_TRUE(ReadAll(&empty).empty());
+
+    LineReader blank(std::string_view("\n"));
+    EXPECT_EQ((std::vector<std::string>{""}), ReadAll(&blank));
+}
+
+TEST_F(LineReaderTest, SmallBufferGrowsForLongLines) {
+    const auto path = test_dir_ / "long.txt";
+    std::string content;
+    std::vector<std::string> expected;
+    for (int i = 0; i < 200; ++i) {
+        expected.push_back(std::string(i * 7 % 97, static_cast<char>('a' + i % 26)));
+        content += expected.back() + (i % 3 == 0 ? "\r\n" : "\n");
+    }
+    ASSERT_TRUE(WriteFile(path, content));
+
+    auto reader = LineReader::Open(path, 4);
+    ASSERT_TRUE(reader.has_value());
+    EXPECT_EQ(expected, ReadAll(&*reader));
+}
+
+TEST_F(LineReaderTest, CustomSource) {
+    // Delivers the input one byte per call.
+    const std::string input = "alpha\nbeta\ngamma";
+    size_t offset = 0;
+    LineReader reader(
+        [&](char* buffer, size_t capacity) -> std::optional<size_t> {
+            if (offset == input.size() || capacity == 0) {
+                return 0;
+            }
+            buffer[0] = input[offset++];
+            return 1;
+        },
+        8);
+    EXPECT_EQ((std::vector<std::string>{"alpha", "beta", "gamma"}), ReadAll(&reader));
+}
+
+TEST_F(LineReaderTest, SourceError) {
+    bool called = false;
+    LineReader reader([&](char* buffer, size_t) -> std::optional<size_t> {
+        if (called) {
+            return std::nullopt;
+        }
+        called = true;
+        std::memcpy(buffer, "ok\npartial", 10);
+        return 10;
+    });
+    std::string_view line;
+    ASSERT_TRUE(reader.Next(&line));
+    EXPECT_EQ("ok", line);
+    // The error marks the end of input; the buffered tail is still returned.
+    ASSERT_TRUE(reader.Next(&line));
+    EXPECT_EQ("partial", line);
+    EXPECT_FALSE(reader.Next(&line));
+    EXPECT_TRUE(reader.HasError());
+}
+
+TEST_F(LineReaderTest, MissingFileAndMove) {
+    EXPECT_FALSE(LineReader::Open(test_dir_ / "missing.txt").has_value());
+
+    const auto path = test_dir_ / "lines.txt";
+    ASSERT_TRUE(WriteFile(path, "x\ny\n"));
+    auto reader = LineReader::Open(path);
+    ASSERT_TRUE(reader.has_value());
+    std::string_view line;
+    ASSERT_TRUE(reader->Next(&line));
+    LineReader moved = std::move(*reader);
+    ASSERT_TRUE(moved.Next(&line));
+    EXPECT_EQ("y", line);
+    EXPECT_FALSE(moved.Next(&line));
+    EXPECT_FALSE(reader->Next(&line));
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace cpp_utils
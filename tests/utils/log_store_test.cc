@@ -0,0 +1,171 @@
+#include "src/utils/log_store.h"
+
+#include <filesystem>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "src/utils/file_utils.h"
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+class LogStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir_ = std::filesystem::temp_directory_path() / "cpp_utils_log_store_test";
+        std::filesystem::remove_all(test_dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(test_dir_);
+    }
+
+    std::filesystem::path test_dir_;
+};
+
+TEST_F(LogStoreTest, PutGetErase) {
+    auto store = LogStore::Open(test_dir_);
+    ASSERT_NE(nullptr, store);
+    EXPECT_EQ(0u, store->Size());
+
+    EXPECT_TRUE(store->Put("a", "1"));
+    EXPECT_TRUE(store->Put("b", ""));
+    EXPECT_TRUE(store->Put("a", "one"));
+    EXPECT_EQ(2u, store->Size());
+    EXPECT_EQ("one", store->Get("a").value_or("<missing>"));
+    EXPECT_EQ("", store->Get("b").value_or("<missing>"));
+    EXPECT_FALSE(store->Get("c").has_value());
+
+    EXPECT_TRUE(store->Erase("a"));
+    EXPECT_FALSE(store->Erase("a"));
+    EXPECT_FALSE(store->Contains("a"));
+    EXPECT_TRUE(store->Contains("b"));
+    EXPECT_EQ(1u, store->Size());
+}
+
+TEST_F(LogStoreTest, RecoversAfterReopen) {
+    {
+        auto store = LogStore::Open(test_dir_);
+        ASSERT_NE(nullptr, store);
+        store->Put("kept", "v1");
+        store->Put("replaced", "old");
+        store->Put("replaced", "new");
+        store->Put("erased", "x");
+        store->Erase("erased");
+    }
+    auto store = LogStore::Open(test_dir_);
+    ASSERT_NE(nullptr, store);
+    EXPECT_EQ(2u, store->Size());
+    EXPECT_EQ("v1", store->Get("kept").value_or("<missing>"));
+    EXPECT_EQ("new", store->Get("replaced").value_or("<missing>"));
+    EXPECT_FALSE(store->Contains("erased"));
+
+    // Appending continues where the previous run stopped.
+    EXPECT_TRUE(store->Put("later", "v2"));
+    EXPECT_EQ(1u, store->SegmentCount());
+}
+
+TEST_F(LogStoreTest, CutsOffTornRecord) {
+    {
+        auto store = LogStore::Open(test_dir_);
+        ASSERT_NE(nullptr, store);
+        store->Put("first", "intact");
+        store->Put("second", "torn");
+    }
+    const auto segment = test_dir_ / "segment-000000.log";
+    const auto size = GetFileSize(segment);
+    ASSERT_TRUE(size.has_value());
+    std::filesystem::resize_file(segment, *size - 2);
+
+    auto store = LogStore::Open(test_dir_);
+    ASSERT_NE(nullptr, store);
+    EXPECT_EQ("intact", store->Get("first").value_or("<missing>"));
+    EXPECT_FALSE(store->Contains("second"));
+    EXPECT_TRUE(store->Put("third", "after"));
+    store.reset();
+
+    store = LogStore::Open(test_dir_);
+    ASSERT_NE(nullptr, store);
+    EXPECT_EQ(2u, store->Size());
+    EXPECT_EQ("after", store->Get("third").value_or("<missing>"));
+}
+
+TEST_F(LogStoreTest, RollsSegmentsAndCompacts) {
+    LogStoreOptions options;
+    options.segment_bytes = 1024;
+    options.compaction_ratio = 0;  // Only compact when asked.
+    auto store = LogStore::Open(test_dir_, options);
+    ASSERT_NE(nullptr, store);
+
+    const std::string value(100, 'v');
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 0; i < 20; ++i) {
+            ASSERT_TRUE(store->Put("key" + std::to_string(i), value + std::to_string(round)));
+        }
+    }
+    EXPECT_GT(store->SegmentCount(), 5u);
+    const uint64_t before = store->DiskBytes();
+
+    ASSERT_TRUE(store->Compact());
+    EXPECT_LT(store->DiskBytes(), before / 3);
+    EXPECT_EQ(20u, store->Size());
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(value + "4", store->Get("key" + std::to_string(i)).value_or("<missing>"));
+    }
+    store.reset();
+
+    store = LogStore::Open(test_dir_, options);
+    ASSERT_NE(nullptr, store);
+    EXPECT_EQ(20u, store->Size());
+    EXPECT_EQ(value + "4", store->Get("key7").value_or("<missing>"));
+}
+
+TEST_F(LogStoreTest, SegmentIdsOutgrowSixDigits) {
+    LogStoreOptions options;
+    options.segment_bytes = 64;
+    options.compaction_ratio = 0;
+    {
+        auto store = LogStore::Open(test_dir_, options);
+        ASSERT_NE(nullptr, store);
+        ASSERT_TRUE(store->Put("old", std::string(100, 'o')));
+    }
+    std::filesystem::rename(test_dir_ / "segment-000000.log", test_dir_ / "segment-999999.log");
+    // Files that merely look like segments are left alone.
+    ASSERT_TRUE(WriteFile(test_dir_ / "segment-.log", "x"));
+    ASSERT_TRUE(WriteFile(test_dir_ / "segment-4294967296.log", "x"));
+    ASSERT_TRUE(WriteFile(test_dir_ / "segment-12a.log", "x"));
+    {
+        auto store = LogStore::Open(test_dir_, options);
+        ASSERT_NE(nullptr, store);
+        ASSERT_TRUE(store->Put("new", "n"));
+    }
+    EXPECT_TRUE(std::filesystem::exists(test_dir_ / "segment-1000000.log"));
+
+    auto store = LogStore::Open(test_dir_, options);
+    ASSERT_NE(nullptr, store);
+    EXPECT_EQ(2u, store->SegmentCount());
+    EXPECT_EQ(std::string(100, 'o'), store->Get("old").value_or("<missing>"));
+    EXPECT_EQ("n", store->Get("new").value_or("<missing>"));
+}
+
+TEST_F(LogStoreTest, CompactsAutomaticallyWhenMostlyGarbage) {
+    LogStoreOptions options;
+    options.segment_bytes = 1024;
+    auto store = LogStore::Open(test_dir_, options);
+    ASSERT_NE(nullptr, store);
+
+    const std::string value(100, 'v');
+    for (int round = 0; round < 200; ++round) {
+        ASSERT_TRUE(store->Put("hot", value + std::to_string(round)));
+    }
+    ASSERT_TRUE(store->Put("cold", "c"));
+    // Without compaction this would be about 20 KiB over 20 segments.
+    EXPECT_LE(store->SegmentCount(), 3u);
+    EXPECT_EQ(value + "199", store->Get("hot").value_or("<missing>"));
+    EXPECT_EQ("c", store->Get("cold").value_or("<missing>"));
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace cpp_utils
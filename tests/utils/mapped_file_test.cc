@@ -0,0 +1,76 @@
+#include "src/utils/mapped_file.h"
+
+#include <filesystem>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "src/utils/file_utils.h"
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+class MappedFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir_ = std::filesystem::temp_directory_path() / "cpp_utils_mapped_file_test";
+        std::filesystem::remove_all(test_dir_);
+        std::filesystem::create_directory(test_dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(test_dir_);
+    }
+
+    std::filesystem::path test_dir_;
+};
+
+TEST_F(MappedFileTest, MapsContents) {
+    const auto path = test_dir_ / "data.txt";
+    std::string content(100000, 'x');
+    content.replace(50000, 6, "needle");
+    ASSERT_TRUE(WriteFile(path, content));
+
+    MapOptions options;
+    options.will_need = true;
+    options.huge_pages = true;
+    auto mapped = MappedFile::Open(path, options);
+    ASSERT_TRUE(mapped.has_value());
+    EXPECT_EQ(content.size(), mapped->Size());
+    EXPECT_EQ(content, mapped->View());
+    EXPECT_EQ(50000, mapped->View().find("needle"));
+}
+
+TEST_F(MappedFileTest, EmptyAndMissingFiles) {
+    const auto empty = test_dir_ / "empty.txt";
+    ASSERT_TRUE(WriteFile(empty, ""));
+    auto mapped = MappedFile::Open(empty);
+    ASSERT_TRUE(mapped.has_value());
+    EXPECT_EQ(0, mapped->Size());
+    EXPECT_TRUE(mapped->View().empty());
+
+    EXPECT_FALSE(MappedFile::Open(test_dir_ / "missing.txt").has_value());
+    EXPECT_FALSE(MappedFile::Open(test_dir_).has_value());
+}
+
+TEST_F(MappedFileTest, Move) {
+    const auto path = test_dir_ / "data.txt";
+    ASSERT_TRUE(WriteFile(path, "hello"));
+    auto mapped = MappedFile::Open(path);
+    ASSERT_TRUE(mapped.has_value());
+
+    MappedFile moved = std::move(*mapped);
+    EXPECT_EQ("hello", moved.View());
+    EXPECT_EQ(nullptr, mapped->Data());
+
+    MapOptions random;
+    random.random = true;
+    auto other = MappedFile::Open(path, random);
+    ASSERT_TRUE(other.has_value());
+    moved = std::move(*other);
+    EXPECT_EQ("hello", moved.View());
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace cpp_utils
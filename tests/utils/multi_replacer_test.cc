@@ -0,0 +1,97 @@
+#include "src/utils/multi_replacer.h"
+
+#include <random>
+#include <string>
+#include <gtest/gtest.h>
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+using Replacements = std::vector<std::pair<std::string, std::string>>;
+
+// Straightforward leftmost-longest replacement used as the reference.
+std::string NaiveReplace(std::string_view input, const Replacements& replacements) {
+    std::string out;
+    size_t pos = 0;
+    while (pos < input.size()) {
+        const std::pair<std::string, std::string>* best = nullptr;
+        for (const auto& r : replacements) {
+            if (!r.first.empty() && input.substr(pos, r.first.size()) == r.first &&
+                (best == nullptr || r.first.size() > best->first.size())) {
+                best = &r;
+            }
+        }
+        if (best != nullptr) {
+            out += best->second;
+            pos += best->first.size();
+        } else {
+            out += input[pos++];
+        }
+    }
+    return out;
+}
+
+TEST(MultiReplacerTest, Basic) {
+    MultiReplacer replacer({{"password", "***"}, {"token", "<t>"}, {"", "ignored"}});
+    EXPECT_EQ(2, replacer.PatternCount());
+    EXPECT_EQ("user=bob *** =x <t>=y", replacer.Apply("user=bob password =x token=y"));
+    EXPECT_EQ("", replacer.Apply(""));
+    EXPECT_EQ("nothing here", replacer.Apply("nothing here"));
+
+    std::string buffer = "stale";
+    replacer.Apply("tokentoken", &buffer);
+    EXPECT_EQ("<t><t>", buffer);
+}
+
+TEST(MultiReplacerTest, LeftmostLongest) {
+    MultiReplacer replacer({{"b", "1"}, {"abc", "2"}, {"abcd", "3"}, {"cd", "4"}});
+    EXPECT_EQ("3", replacer.Apply("abcd"));
+    EXPECT_EQ("2x", replacer.Apply("abcx"));
+    EXPECT_EQ("a1x", replacer.Apply("abx"));
+    EXPECT_EQ("x14", replacer.Apply("xbcd"));
+}
+
+TEST(MultiReplacerTest, DuplicatePatternsKeepFirst) {
+    MultiReplacer replacer({{"a", "1"}, {"a", "2"}});
+    EXPECT_EQ(1, replacer.PatternCount());
+    EXPECT_EQ("11", replacer.Apply("aa"));
+}
+
+TEST(MultiReplacerTest, MatchesNaiveOnRandomInput) {
+    std::mt19937 rng(7);
+    auto random_string = [&rng](size_t max_length) {
+        std::string s(1 + rng() % max_length, 'a');
+        for (char& c : s) {
+            c = static_cast<char>('a' + rng() % 3);
+        }
+        return s;
+    };
+
+    for (int trial = 0; trial < 200; ++trial) {
+        Replacements replacements;
+        const size_t count = 1 + rng() % 6;
+        for (size_t i = 0; i < count; ++i) {
+            replacements.emplace_back(random_string(4), std::to_string(i));
+        }
+        // Deduplicate the reference the same way: first pattern wins
+        Replacements unique;
+        for (const auto& r : replacements) {
+            bool seen = false;
+            for (const auto& u : unique) {
+                seen = seen || u.first == r.first;
+            }
+            if (!seen) {
+                unique.push_back(r);
+            }
+        }
+
+        MultiReplacer replacer(replacements);
+        const std::string input = random_string(40);
+        EXPECT_EQ(NaiveReplace(input, unique), replacer.Apply(input)) << input;
+    }
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace cpp_utils
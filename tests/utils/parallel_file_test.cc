@@ -0,0 +1,132 @@
+#include "src/utils/parallel_file.h"
+
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "src/utils/counter_utils.h"
+#include "src/utils/file_utils.h"
+#include "src/utils/string_utils.h"
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+class ParallelFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir_ = std::filesystem::temp_directory_path() / "cpp_utils_parallel_file_test";
+        std::filesystem::remove_all(test_dir_);
+        std::filesystem::create_directory(test_dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(test_dir_);
+    }
+
+    // Writes enough lines to span several chunks; line i holds words "w<i % 10>" repeated.
+    std::filesystem::path WriteLargeFile(size_t lines) {
+        const auto path = test_dir_ / "large.txt";
+        std::string content;
+        for (size_t i = 0; i < lines; ++i) {
+            const std::string word = "w" + std::to_string(i % 10);
+            content += word + " " + word + " filler filler filler filler filler filler\n";
+        }
+        EXPECT_TRUE(WriteFile(path, content));
+        return path;
+    }
+
+    std::filesystem::path test_dir_;
+};
+
+TEST_F(ParallelFileTest, SplitAtLineBoundaries) {
+    const std::string data = "aa\nbbbb\nc\ndddddd\ne";
+    const auto pieces = SplitAtLineBoundaries(data, 3);
+    std::string joined;
+    for (size_t i = 0; i < pieces.size(); ++i) {
+        if (i + 1 < pieces.size()) {
+            EXPECT_EQ('\n', pieces[i].back());
+        }
+        joined += pieces[i];
+    }
+    EXPECT_EQ(data, joined);
+    EXPECT_GE(pieces.size(), 2);
+
+    EXPECT_EQ(1, SplitAtLineBoundaries("no newline at all", 4).size());
+    EXPECT_TRUE(SplitAtLineBoundaries("", 4).empty());
+}
+
+TEST_F(ParallelFileTest, ForEachLineVisitsEveryLine) {
+    const size_t kLines = 100000;
+    const auto path = WriteLargeFile(kLines);
+
+    std::atomic<size_t> lines{0};
+    std::atomic<size_t> bytes{0};
+    ASSERT_TRUE(ParallelForEachLine(path, [&](std::string_view line) {
+        lines.fetch_add(1);
+        bytes.fetch_add(line.size() + 1);
+    }, 4));
+    EXPECT_EQ(kLines, lines.load());
+    EXPECT_EQ(*GetFileSize(path), bytes.load());
+}
+
+TEST_F(ParallelFileTest, ForEachChunkWorkerIndices) {
+    const auto path = WriteLargeFile(100000);
+    std::mutex mutex;
+    std::vector<size_t> workers;
+    size_t total = 0;
+    ASSERT_TRUE(ParallelForEachChunk(path, [&](size_t worker, std::string_view chunk) {
+        std::lock_guard<std::mutex> lock(mutex);
+        workers.push_back(worker);
+        total += chunk.size();
+    }, 3));
+    EXPECT_EQ(*GetFileSize(path), total);
+    for (size_t worker : workers) {
+        EXPECT_LT(worker, 3);
+    }
+}
+
+TEST_F(ParallelFileTest, ReduceWithCounter) {
+    const size_t kLines = 100000;
+    const auto path = WriteLargeFile(kLines);
+
+    CounterTp<std::string, std::string_view> words([](std::string_view word) { return std::string(word); });
+    auto counts = ParallelReduceLines(path, words, [](auto* counter, std::string_view line) {
+        for (std::string_view word : SplitRange(line, ' ')) {
+            counter->Count(word);
+        }
+    }, 4);
+    ASSERT_TRUE(counts.has_value());
+    const auto& map = counts->GetCountMap();
+    EXPECT_EQ(11, map.size());
+    EXPECT_EQ(static_cast<int32_t>(kLines / 10 * 2), map.at("w3"));
+    EXPECT_EQ(static_cast<int32_t>(kLines * 6), map.at("filler"));
+}
+
+TEST_F(ParallelFileTest, ReduceWithMergeFunction) {
+    const auto path = test_dir_ / "small.txt";
+    ASSERT_TRUE(WriteFile(path, "1\n2\r\n3\n4"));
+    auto sum = ParallelReduceLines(
+        path, int64_t{0},
+        [](int64_t* total, std::string_view line) { *total += *ToInt64(line); },
+        [](int64_t* into, int64_t from) { *into += from; });
+    ASSERT_TRUE(sum.has_value());
+    EXPECT_EQ(10, *sum);
+}
+
+TEST_F(ParallelFileTest, MissingAndEmptyFiles) {
+    EXPECT_FALSE(ParallelForEachLine(test_dir_ / "missing.txt", [](std::string_view) {}));
+
+    const auto empty = test_dir_ / "empty.txt";
+    ASSERT_TRUE(WriteFile(empty, ""));
+    size_t lines = 0;
+    EXPECT_TRUE(ParallelForEachLine(empty, [&](std::string_view) { ++lines; }));
+    EXPECT_EQ(0, lines);
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace cpp_utils
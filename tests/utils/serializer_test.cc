@@ -0,0 +1,63 @@
+#include "src/utils/serializer.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <gtest/gtest.h>
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+TEST(SerializerTest, RoundTripsArithmeticValues) {
+    std::string encoded;
+    Serializer<int32_t>::Encode(-7, &encoded);
+    Serializer<uint64_t>::Encode(uint64_t{1} << 40, &encoded);
+    Serializer<double>::Encode(2.5, &encoded);
+    EXPECT_EQ(4u + 8u + 8u, encoded.size());
+
+    std::string_view input(encoded);
+    int32_t i = 0;
+    uint64_t u = 0;
+    double d = 0;
+    ASSERT_TRUE(Serializer<int32_t>::Decode(&input, &i));
+    ASSERT_TRUE(Serializer<uint64_t>::Decode(&input, &u));
+    ASSERT_TRUE(Serializer<double>::Decode(&input, &d));
+    EXPECT_EQ(-7, i);
+    EXPECT_EQ(uint64_t{1} << 40, u);
+    EXPECT_EQ(2.5, d);
+    EXPECT_TRUE(input.empty());
+}
+
+TEST(SerializerTest, RoundTripsStrings) {
+    std::string encoded;
+    Serializer<std::string>::Encode("", &encoded);
+    Serializer<std::string>::Encode(std::string(300, 'x'), &encoded);
+    Serializer<std::string>::Encode(std::string("a\0b", 3), &encoded);
+
+    std::string_view input(encoded);
+    std::string value;
+    ASSERT_TRUE(Serializer<std::string>::Decode(&input, &value));
+    EXPECT_EQ("", value);
+    ASSERT_TRUE(Serializer<std::string>::Decode(&input, &value));
+    EXPECT_EQ(std::string(300, 'x'), value);
+    ASSERT_TRUE(Serializer<std::string>::Decode(&input, &value));
+    EXPECT_EQ(std::string("a\0b", 3), value);
+    EXPECT_TRUE(input.empty());
+}
+
+TEST(SerializerTest, RejectsTruncatedInput) {
+    std::string encoded;
+    Serializer<std::string>::Encode("hello", &encoded);
+    std::string_view input(encoded.data(), encoded.size() - 1);
+    std::string value;
+    EXPECT_FALSE(Serializer<std::string>::Decode(&input, &value));
+
+    input = std::string_view("abc");
+    int32_t i = 0;
+    EXPECT_FALSE(Serializer<int32_t>::Decode(&input, &i));
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace cpp_utils
@@ -0,0 +1,68 @@
+#include "src/utils/string_builder.h"
+
+#include <string>
+#include <gtest/gtest.h>
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+TEST(StringBuilderTest, AppendAndView) {
+    StringBuilder builder;
+    EXPECT_EQ(0, builder.Size());
+    EXPECT_EQ(StringBuilder::kInlineCapacity, builder.Capacity());
+
+    builder.Append("id=").AppendInt(-42).Append(',').Append("n=").AppendUint(7)
+        .Append(',').Append("x=").AppendDouble(0.5);
+    EXPECT_EQ("id=-42,n=7,x=0.5", builder.View());
+    EXPECT_EQ("id=-42,n=7,x=0.5", builder.ToString());
+
+    builder.Clear();
+    EXPECT_EQ("", builder.View());
+    builder.Append("again");
+    EXPECT_EQ("again", builder.View());
+}
+
+TEST(StringBuilderTest, GrowsPastInlineBuffer) {
+    StringBuilder builder;
+    std::string expected;
+    for (int i = 0; i < 1000; ++i) {
+        builder.AppendInt(i).Append(' ');
+        expected += std::to_string(i) + " ";
+    }
+    EXPECT_EQ(expected, builder.View());
+    EXPECT_GE(builder.Capacity(), expected.size());
+}
+
+TEST(StringBuilderTest, ReserveAllocatesOnce) {
+    StringBuilder builder(4096);
+    EXPECT_EQ(4096, builder.Capacity());
+    for (int i = 0; i < 4096; ++i) {
+        builder.Append('x');
+    }
+    EXPECT_EQ(4096, builder.Capacity());
+    EXPECT_EQ(std::string(4096, 'x'), builder.View());
+}
+
+TEST(StringBuilderTest, Move) {
+    StringBuilder small;
+    small.Append("inline");
+    StringBuilder moved_small(std::move(small));
+    EXPECT_EQ("inline", moved_small.View());
+    EXPECT_EQ(0, small.Size());
+
+    StringBuilder large;
+    large.Append(std::string(1000, 'y'));
+    StringBuilder moved_large;
+    moved_large = std::move(large);
+    EXPECT_EQ(std::string(1000, 'y'), moved_large.View());
+    EXPECT_EQ(0, large.Size());
+
+    // Moved-from builders remain usable
+    large.Append("ok");
+    EXPECT_EQ("ok", large.View());
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace cpp_utils
@@ -0,0 +1,76 @@
+#include "src/utils/string_interner.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+TEST(StringInternerTest, InternAndLookup) {
+    StringInterner interner;
+    EXPECT_EQ(0, interner.Size());
+
+    const auto get = interner.Intern("GET");
+    const auto post = interner.Intern("POST");
+    EXPECT_EQ(0, get);
+    EXPECT_EQ(1, post);
+    EXPECT_EQ(get, interner.Intern(std::string("GET")));
+    EXPECT_EQ(2, interner.Size());
+
+    EXPECT_EQ("GET", interner.Lookup(get));
+    EXPECT_EQ("POST", interner.Lookup(post));
+    EXPECT_EQ(post, interner.Find("POST"));
+    EXPECT_FALSE(interner.Find("PUT").has_value());
+
+    // Empty strings are valid too
+    const auto empty = interner.Intern("");
+    EXPECT_EQ("", interner.Lookup(empty));
+    EXPECT_EQ(empty, interner.Intern(""));
+}
+
+TEST(StringInternerTest, ViewsStayStable) {
+    StringInterner interner(16);
+    std::string_view first = interner.InternView("first value");
+    // Enough strings to force new blocks, plus one larger than a block
+    for (int i = 0; i < 1000; ++i) {
+        interner.Intern("value" + std::to_string(i));
+    }
+    std::string_view large = interner.InternView(std::string(100, 'x'));
+    EXPECT_EQ("first value", first);
+    EXPECT_EQ(first.data(), interner.InternView("first value").data());
+    EXPECT_EQ(std::string(100, 'x'), large);
+    EXPECT_GE(interner.ArenaBytes(), 100);
+}
+
+TEST(StringInternerTest, ConcurrentIntern) {
+    StringInterner interner;
+    const int kThreads = 4;
+    const int kValues = 500;
+    std::vector<std::vector<StringInterner::Id>> ids(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&interner, &ids, t]() {
+            for (int i = 0; i < kValues; ++i) {
+                ids[t].push_back(interner.Intern("value" + std::to_string(i)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(kValues, interner.Size());
+    for (int t = 1; t < kThreads; ++t) {
+        EXPECT_EQ(ids[0], ids[t]);
+    }
+    for (int i = 0; i < kValues; ++i) {
+        EXPECT_EQ("value" + std::to_string(i), interner.Lookup(ids[0][i]));
+    }
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace cpp_utils
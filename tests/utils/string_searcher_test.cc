@@ -0,0 +1,58 @@
+#include "src/utils/string_searcher.h"
+
+#include <random>
+#include <string>
+#include <gtest/gtest.h>
+
+namespace cpp_utils {
+namespace utils {
+namespace {
+
+TEST(StringSearcherTest, Find) {
+    StringSearcher searcher("needle");
+    EXPECT_EQ("needle", searcher.Needle());
+    EXPECT_EQ(0, searcher.Find("needle in a haystack"));
+    EXPECT_EQ(9, searcher.Find("haystack needle"));
+    EXPECT_EQ(std::string_view::npos, searcher.Find("haystack needl"));
+    EXPECT_EQ(std::string_view::npos, searcher.Find(""));
+    EXPECT_EQ(std::string_view::npos, searcher.Find("needle", 1));
+    EXPECT_EQ(std::string_view::npos, searcher.Find("needle", 100));
+    EXPECT_TRUE(searcher.Contains("a needle"));
+    EXPECT_FALSE(searcher.Contains("a noodle"));
+
+    // Empty and single-byte needles behave like std::string_view::find
+    EXPECT_EQ(3, StringSearcher("").Find("abc", 3));
+    EXPECT_EQ(std::string_view::npos, StringSearcher("").Find("abc", 4));
+    EXPECT_EQ(2, StringSearcher("c").Find("abc"));
+}
+
+TEST(StringSearcherTest, MatchesStdFindOnRandomInput) {
+    std::mt19937 rng(3);
+    auto random_string = [&rng](size_t length) {
+        std::string s(length, 'a');
+        for (char& c : s) {
+            c = static_cast<char>('a' + rng() % 3);
+        }
+        return s;
+    };
+
+    for (size_t needle_size : {1, 2, 3, 5, 17, 40}) {
+        for (size_t haystack_size : {0, 1, 16, 33, 64, 100, 1000}) {
+            const std::string needle = random_string(needle_size);
+            std::string haystack = random_string(haystack_size);
+            // Plant the needle so long needles are found too
+            if (haystack_size >= needle_size) {
+                haystack.replace(rng() % (haystack_size - needle_size + 1), needle_size, needle);
+            }
+            const StringSearcher searcher(needle);
+            for (size_t pos = 0; pos <= haystack_size; pos += 1 + haystack_size / 8) {
+                EXPECT_EQ(std::string_view(haystack).find(needle, pos), searcher.Find(haystack, pos))
+                    << needle << " in " << haystack << " from " << pos;
+            }
+        }
+    }
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace cpp_utils
@@ -0,0 +1,84 @@
+#include "src/utils/string_simd.h"
+
+#include <cctype>
+#include <random>
+#include <string>
+#include <gtest/gtest.h>
+
+namespace cpp_utils {
+namespace utils {
+namespace internal {
+namespace {
+
+TEST(StringSimdTest, ByteSet) {
+    ByteSet set(",,;");
+    EXPECT_TRUE(set.Contains(','));
+    EXPECT_TRUE(set.Contains(';'));
+    EXPECT_FALSE(set.Contains('a'));
+    EXPECT_EQ(",;", set.Bytes());
+    EXPECT_TRUE(set.Vectorizable());
+
+    EXPECT_FALSE(ByteSet("").Vectorizable());
+    EXPECT_FALSE(ByteSet("abcdefghij").Vectorizable());
+}
+
+TEST(StringSimdTest, FindFirstOf) {
+    const ByteSet set(",");
+    EXPECT_EQ(std::string_view::npos, FindFirstOf("", 0, set));
+    EXPECT_EQ(std::string_view::npos, FindFirstOf("abc", 0, set));
+    EXPECT_EQ(1, FindFirstOf("a,c", 0, set));
+    EXPECT_EQ(std::string_view::npos, FindFirstOf("a,c", 2, set));
+    EXPECT_EQ(std::string_view::npos, FindFirstOf("a,c", 10, set));
+}
+
+TEST(StringSimdTest, MatchesScalarOnRandomInput) {
+    std::mt19937 rng(42);
+    const std::string alphabet = "abcdefgh,;|\t";
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+
+    for (const char* delimiters : {",", ",;", ";|\t", "abcdefghij,"}) {
+        const ByteSet set(delimiters);
+        for (size_t length : {0, 1, 15, 16, 17, 31, 32, 33, 100, 1000}) {
+            std::string input;
+            for (size_t i = 0; i < length; ++i) {
+                // Mostly non-delimiter bytes, so matches land in every lane
+                input.push_back(rng() % 8 == 0 ? alphabet[pick(rng)] : 'x');
+            }
+            for (size_t pos = 0; pos <= length; pos += 1 + length / 10) {
+                EXPECT_EQ(FindFirstOfScalar(input, pos, set), FindFirstOf(input, pos, set))
+                    << SelectedKernelName() << " " << delimiters << " " << length << " " << pos;
+            }
+        }
+    }
+}
+
+TEST(StringSimdTest, CaseConversionMatchesCLocale) {
+    // Every byte value, repeated at each offset so all vector lanes see it
+    std::string input;
+    for (int round = 0; round < 3; ++round) {
+        for (int c = 0; c < 256; ++c) {
+            input.push_back(static_cast<char>(c));
+        }
+        input.push_back('x');
+    }
+
+    std::string lower(input.size(), '\0');
+    std::string upper(input.size(), '\0');
+    AsciiToLower(input, lower.data());
+    AsciiToUpper(input, upper.data());
+    for (size_t i = 0; i < input.size(); ++i) {
+        const auto c = static_cast<unsigned char>(input[i]);
+        EXPECT_EQ(static_cast<char>(std::tolower(c)), lower[i]) << i;
+        EXPECT_EQ(static_cast<char>(std::toupper(c)), upper[i]) << i;
+    }
+
+    // In place
+    AsciiToUpper(lower, lower.data());
+    AsciiToUpper(upper, upper.data());
+    EXPECT_EQ(upper, lower);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace utils
+}  // namespace cpp_utils
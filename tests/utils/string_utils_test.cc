@@ -1,5 +1,6 @@
 #include "src/utils/string_utils.h"
 
+#include <string_view>
 #include <gtest/gtest.h>
 
 namespace cpp_utils {
@@ -33,6 +34,93 @@ TEST(StringUtilsTest, Split) {
     EXPECT_EQ("two", result[2]);
 }
 
+TEST(StringUtilsTest, SplitView) {
+    std::string input = "one,two,,three,";
+    auto result = SplitView(input, ',');
+
+    ASSERT_EQ(5, result.size());
+    EXPECT_EQ("one", result[0]);
+    EXPECT_EQ("two", result[1]);
+    EXPECT_EQ("", result[2]);
+    EXPECT_EQ("three", result[3]);
+    EXPECT_EQ("", result[4]);
+    // Pieces point into the input
+    EXPECT_EQ(input.data(), result[0].data());
+
+    EXPECT_TRUE(SplitView("", ',').empty());
+
+    // The caller-supplied buffer is cleared and reused
+    std::vector<std::string_view> buffer = {"stale"};
+    EXPECT_EQ(2, SplitView("a b", ' ', &buffer));
+    ASSERT_EQ(2, buffer.size());
+    EXPECT_EQ("a", buffer[0]);
+    EXPECT_EQ("b", buffer[1]);
+}
+
+TEST(StringUtilsTest, SplitLazy) {
+    for (std::string_view input : {"", "single", "one,,two", ",", "a,b,c,"}) {
+        std::vector<std::string_view> lazy(SplitLazy(input, ',').begin(), SplitLazy(input, ',').end());
+        auto eager = Split(input, ',');
+        ASSERT_EQ(eager.size(), lazy.size()) << input;
+        for (size_t i = 0; i < eager.size(); ++i) {
+            EXPECT_EQ(eager[i], lazy[i]) << input;
+        }
+    }
+
+    size_t count = 0;
+    for (std::string_view piece : SplitLazy("x:y:z", ':')) {
+        EXPECT_EQ(1, piece.size());
+        ++count;
+    }
+    EXPECT_EQ(3, count);
+}
+
+TEST(StringUtilsTest, SplitAny) {
+    auto result = SplitAny("a,b;c d", ",; ");
+    ASSERT_EQ(4, result.size());
+    EXPECT_EQ("a", result[0]);
+    EXPECT_EQ("b", result[1]);
+    EXPECT_EQ("c", result[2]);
+    EXPECT_EQ("d", result[3]);
+
+    EXPECT_TRUE(SplitAny("", ",").empty());
+
+    // Long input exercises the vector kernels and agrees with Split
+    std::string long_input;
+    for (int i = 0; i < 100; ++i) {
+        long_input += "field" + std::to_string(i) + (i % 7 == 0 ? ",," : ",");
+    }
+    auto any = SplitAny(long_input, ",");
+    auto split = Split(long_input, ',');
+    ASSERT_EQ(split.size(), any.size());
+    for (size_t i = 0; i < split.size(); ++i) {
+        EXPECT_EQ(split[i], any[i]);
+    }
+}
+
+TEST(StringUtilsTest, SplitCsv) {
+    auto result = SplitCsv(R"(plain,"quoted, with comma","say ""hi""",,last)");
+    ASSERT_EQ(5, result.size());
+    EXPECT_EQ("plain", result[0]);
+    EXPECT_EQ("quoted, with comma", result[1]);
+    EXPECT_EQ("say \"hi\"", result[2]);
+    EXPECT_EQ("", result[3]);
+    EXPECT_EQ("last", result[4]);
+
+    EXPECT_TRUE(SplitCsv("").empty());
+
+    result = SplitCsv("a;'b;c';", ';', '\'');
+    ASSERT_EQ(3, result.size());
+    EXPECT_EQ("a", result[0]);
+    EXPECT_EQ("b;c", result[1]);
+    EXPECT_EQ("", result[2]);
+
+    // Unterminated quotes run to the end of the line
+    result = SplitCsv("x,\"open,field");
+    ASSERT_EQ(2, result.size());
+    EXPECT_EQ("open,field", result[1]);
+}
+
 TEST(StringUtilsTest, Join) {
     std::vector<std::string> strings = {"one", "two", "three"};
     std::string result = Join(strings, ", ");
@@ -46,6 +134,17 @@ TEST(StringUtilsTest, Join) {
     EXPECT_EQ("single", Join(std::vector<std::string>{"single"}, ", "));
 }
 
+TEST(StringUtilsTest, JoinGenericRange) {
+    std::vector<std::string_view> views = {"a", "bb", "ccc"};
+    EXPECT_EQ("a-bb-ccc", Join(views, "-"));
+
+    const char* raw[] = {"x", "y"};
+    EXPECT_EQ("x, y", Join(raw, ", "));
+
+    EXPECT_EQ("", Join(std::vector<std::string_view>{}, ","));
+    EXPECT_EQ("one,two", Join(SplitLazy("one,two", ','), ","));
+}
+
 TEST(StringUtilsTest, Trim) {
     EXPECT_EQ("hello", Trim("  hello  "));
     EXPECT_EQ("hello", Trim("hello  "));
@@ -57,6 +156,15 @@ TEST(StringUtilsTest, Trim) {
     EXPECT_EQ("hello\tworld", Trim("  hello\tworld  "));
 }
 
+TEST(StringUtilsTest, TrimView) {
+    std::string padded = " \t hello world \r\n";
+    std::string_view trimmed = TrimView(padded);
+    EXPECT_EQ("hello world", trimmed);
+    EXPECT_EQ(padded.data() + 3, trimmed.data());
+    EXPECT_EQ("", TrimView("  \n "));
+    EXPECT_EQ("", TrimView(""));
+}
+
 TEST(StringUtilsTest, ToLower) {
     EXPECT_EQ("hello, world!", ToLower("HELLO, World!"));
     EXPECT_EQ("hello", ToLower("hello"));
@@ -71,6 +179,18 @@ TEST(StringUtilsTest, ToUpper) {
     EXPECT_EQ("", ToUpper(""));
 }
 
+TEST(StringUtilsTest, CaseConversionInPlace) {
+    std::string s = "Mixed CASE with 123 and a Long Tail To Cover The Vector Path!";
+    ToLowerInPlace(&s);
+    EXPECT_EQ("mixed case with 123 and a long tail to cover the vector path!", s);
+    ToUpperInPlace(&s);
+    EXPECT_EQ("MIXED CASE WITH 123 AND A LONG TAIL TO COVER THE VECTOR PATH!", s);
+
+    std::string empty;
+    ToLowerInPlace(&empty);
+    EXPECT_EQ("", empty);
+}
+
 TEST(StringUtilsTest, StartsWith) {
     EXPECT_TRUE(StartsWith("Hello, World!", "Hello"));
     EXPECT_TRUE(StartsWith("Hello", "Hello"));
@@ -79,6 +199,9 @@ TEST(StringUtilsTest, StartsWith) {
     EXPECT_TRUE(StartsWith("Hello", ""));
     EXPECT_FALSE(StartsWith("", "Hello"));
     EXPECT_TRUE(StartsWith("", ""));
+    // A default view has a null data pointer, as an empty MappedFile's does.
+    EXPECT_TRUE(StartsWith(std::string_view(), std::string_view()));
+    EXPECT_FALSE(StartsWith(std::string_view(), "a"));
 }
 
 TEST(StringUtilsTest, EndsWith) {
@@ -89,6 +212,8 @@ TEST(StringUtilsTest, EndsWith) {
     EXPECT_TRUE(EndsWith("Hello", ""));
     EXPECT_FALSE(EndsWith("", "Hello"));
     EXPECT_TRUE(EndsWith("", ""));
+    EXPECT_TRUE(EndsWith(std::string_view(), std::string_view()));
+    EXPECT_FALSE(EndsWith(std::string_view(), "a"));
 }
 
 TEST(StringUtilsTest, Replace) {
@@ -101,6 +226,10 @@ TEST(StringUtilsTest, Replace) {
     EXPECT_EQ("Hellx, Wxrld!", Replace("Hello, World!", "o", "x", true));
     // Test single replacement - only first occurrence
     EXPECT_EQ("Hellx, World!", Replace("Hello, World!", "o", "x", false));
+    // Replacements are not rescanned
+    EXPECT_EQ("aaaa", Replace("aa", "a", "aa", true));
+    EXPECT_EQ("b", Replace("aaab", "a", "", true));
+    EXPECT_EQ("xx", Replace("abab", "ab", "x", true));
 }
 
 TEST(StringUtilsTest, ToInt) {
@@ -153,6 +282,55 @@ TEST(StringUtilsTest, ToDouble) {
     EXPECT_FALSE(result.has_value());
 }
 
+TEST(StringUtilsTest, ToIntRejectsPartialAndOutOfRange) {
+    EXPECT_EQ(42, ToInt("+42"));
+    EXPECT_FALSE(ToInt("1-2").has_value());
+    EXPECT_FALSE(ToInt("+-1").has_value());
+    EXPECT_FALSE(ToInt("-").has_value());
+    EXPECT_FALSE(ToInt("99999999999").has_value());
+    EXPECT_FALSE(ToInt("1 2").has_value());
+}
+
+TEST(StringUtilsTest, ToInt64AndToUint64) {
+    EXPECT_EQ(INT64_MAX, ToInt64("9223372036854775807"));
+    EXPECT_EQ(INT64_MIN, ToInt64(" -9223372036854775808 "));
+    EXPECT_FALSE(ToInt64("9223372036854775808").has_value());
+
+    EXPECT_EQ(UINT64_MAX, ToUint64("18446744073709551615"));
+    EXPECT_EQ(7u, ToUint64("+7"));
+    EXPECT_FALSE(ToUint64("-1").has_value());
+    EXPECT_FALSE(ToUint64("").has_value());
+}
+
+TEST(StringUtilsTest, ToDoubleFormats) {
+    EXPECT_DOUBLE_EQ(1.5e10, *ToDouble("1.5e10"));
+    EXPECT_DOUBLE_EQ(-2.5e-3, *ToDouble("-2.5E-3"));
+    EXPECT_DOUBLE_EQ(0.5, *ToDouble(".5"));
+    EXPECT_DOUBLE_EQ(3.0, *ToDouble("+3"));
+    EXPECT_FALSE(ToDouble("inf").has_value());
+    EXPECT_FALSE(ToDouble("nan").has_value());
+    EXPECT_FALSE(ToDouble("0x1p3").has_value());
+    EXPECT_FALSE(ToDouble("1e").has_value());
+    EXPECT_FALSE(ToDouble("1e999").has_value());
+    EXPECT_FALSE(ToDouble(".").has_value());
+
+    auto f = ToFloat("0.25");
+    ASSERT_TRUE(f.has_value());
+    EXPECT_FLOAT_EQ(0.25f, *f);
+}
+
+TEST(StringUtilsTest, Columns) {
+    auto ints = ToInt64Column(SplitView("1,-2, 3", ','));
+    ASSERT_TRUE(ints.has_value());
+    EXPECT_EQ((std::vector<int64_t>{1, -2, 3}), *ints);
+    EXPECT_FALSE(ToInt64Column(SplitView("1,x,3", ',')).has_value());
+
+    auto doubles = ToDoubleColumn(SplitView("1.5,2", ','));
+    ASSERT_TRUE(doubles.has_value());
+    EXPECT_EQ((std::vector<double>{1.5, 2.0}), *doubles);
+    EXPECT_TRUE(ToDoubleColumn({})->empty());
+}
+
 }  // namespace
 }  // namespace utils
 }  // namespace cpp_utils